@@ -0,0 +1,151 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../aocDays.h"
+
+/* Runs any of the days from a single program so a batch of inputs across
+ * several days doesn't pay for a process per day. Each input is a job on the
+ * worker pool and the output stays in argument order however the jobs were
+ * scheduled. All of the days are linked in:
+ *
+ * cc -ansi -pedantic -O2 -DAOC_NO_MAIN -DAOC_USE_THREADS \
+ *	-D_POSIX_C_SOURCE=200112L -pthread aoc/main.c day_??/main.c -o aoc
+ *
+ * usage: aoc [-j threads] day:file ... or aoc [-j threads] day file ...
+ *
+ * A bare day number applies to every plain file after it, so both forms can
+ * be mixed, eg: aoc 1 a.txt b.txt 2:c.txt. One of the files can be "-" to
+ * read that input from stdin, eg: zcat c.txt.gz | aoc 1 a.txt 2:- */
+
+/* Accepts a day number on its own or one followed by ':' and a path */
+static AOC_BOOL parseDayPrefix(const char *arg, int *day, const char **path)
+{
+	char *end = NULL;
+	long int val = strtol(arg, &end, 10);
+
+	if ((end == arg) || (val < 1) || (val > AOC_NUM_DAYS)
+	|| ((*end != '\0') && (*end != ':')))
+	{
+		return AOC_FALSE;
+	}
+
+	*day = val;
+	*path = (*end == ':') ? end + 1 : NULL;
+
+	return AOC_TRUE;
+}
+
+static AOC_STAT parseJobs(int argc, char **argv, struct aocDayJob *jobs,
+	size_t *num_jobs)
+{
+	const struct aocDay *current = NULL;
+	AOC_BOOL seen_stdin = AOC_FALSE;
+	size_t len = 0;
+	int i;
+
+	for (i = 0; i < argc; i++)
+	{
+		const char *path = argv[i];
+		int number;
+
+		if (parseDayPrefix(argv[i], &number, &path) == AOC_TRUE)
+		{
+			if (dayLookup(number) == NULL)
+			{
+				fprintf(stderr, "Day %d isn't solved\n", 
+					number);
+
+				return AOC_FAILURE;
+			}
+
+			if (path == NULL)
+			{
+				current = dayLookup(number);
+
+				continue;
+			}
+
+			jobs[len].day = dayLookup(number);
+		}
+		else if (current != NULL)
+		{
+			jobs[len].day = current;
+		}
+		else
+		{
+			fprintf(stderr, "No day given for file '%s'\n", 
+				argv[i]);
+
+			return AOC_FAILURE;
+		}
+
+		if (AOC_IS_STDIN_PATH(path))
+		{
+			if (seen_stdin == AOC_TRUE)
+			{
+				fputs("Stdin ('-') can only be given once\n", 
+					stderr);
+
+				return AOC_FAILURE;
+			}
+
+			seen_stdin = AOC_TRUE;
+		}
+
+		jobs[len].path = path;
+		len++;
+	}
+
+	*num_jobs = len;
+
+	return AOC_SUCCESS;
+}
+
+int main(int argc, char **argv)
+{
+	struct aocDayJob *jobs = NULL;
+	struct aocPool *pool = NULL;
+	size_t num_threads = poolDefaultThreads();
+	size_t num_jobs = 0;
+	int ret = AOC_SUCCESS;
+	double start;
+	int first;
+
+	if (((first = parseThreadsOption(argc, argv, &num_threads) + 1) < 1)
+	|| (first >= argc))
+	{
+		fputs("usage: aoc [-j threads] day:file ... "
+			"or aoc [-j threads] day file ...\n", stderr);
+
+		return AOC_FAILURE;
+	}
+
+	if ((jobs = malloc(sizeof(struct aocDayJob) * (argc - first))) == NULL)
+	{
+		return AOC_FAILURE;
+	}
+
+	if ((parseJobs(argc - first, argv + first, jobs, &num_jobs)
+		!= AOC_SUCCESS)
+	|| ((pool = poolCreate(AOC_MIN(num_threads, num_jobs))) == NULL))
+	{
+		AOC_FREE(jobs);
+
+		return AOC_FAILURE;
+	}
+
+	start = clockSeconds();
+	ret = runDayJobs(pool, jobs, num_jobs, num_threads, stdout, 
+		AOC_TRUE);
+
+	if (first > 1)
+	{
+		reportThroughput(num_jobs, clockSeconds() - start);
+	}
+
+	poolDestroy(pool);
+	AOC_FREE(jobs);
+
+	return ret;
+}
@@ -12,6 +12,9 @@
 
 #include <stdio.h> /* for getFileLength */
 #include <stdlib.h>
+#include <string.h> /* for memset */
+#include <limits.h>
+#include <time.h> /* for clockSeconds */
 
 #ifndef AOC_MEMMOVE
 #include <string.h>
@@ -23,11 +26,44 @@
 #define AOC_ASSERT assert
 #endif /* AOC_ASSERT */
 
-#define AOC_NEW_DYN_ARR(type, arr_ptr, max)       \
-do                                                \
-{                                                 \
-	(arr_ptr) = malloc(sizeof(type) * (max)); \
-	AOC_ASSERT((arr_ptr) != NULL);            \
+/* Memory mapping input files is opt-in as it needs POSIX, build with
+ * -DAOC_USE_MMAP -D_POSIX_C_SOURCE=200112L to enable it */
+#if defined(AOC_USE_MMAP)
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif /* AOC_USE_MMAP */
+
+/* The worker pool only runs tasks concurrently when built with 
+ * -DAOC_USE_THREADS -D_POSIX_C_SOURCE=200112L -pthread, otherwise each task
+ * is run in place as it is submitted */
+#if defined(AOC_USE_THREADS)
+#include <pthread.h>
+#include <unistd.h>
+#endif /* AOC_USE_THREADS */
+
+/* Every allocation made through the macros below can be accounted for per
+ * call site by building with -DAOC_ALLOC_STATS, see allocStatsReport */
+#if defined(AOC_ALLOC_STATS)
+#define AOC_MALLOC(size) allocStatsMalloc((size), __FILE__, __LINE__)
+#define AOC_REALLOC(ptr, size) \
+	allocStatsRealloc((ptr), (size), __FILE__, __LINE__)
+#define AOC_RELEASE(ptr) allocStatsFree(ptr)
+#define AOC_NOTE_MOVE(bytes) allocStatsMove((bytes), __FILE__, __LINE__)
+#else
+#define AOC_MALLOC(size) malloc(size)
+#define AOC_REALLOC(ptr, size) realloc((ptr), (size))
+#define AOC_RELEASE(ptr) free(ptr)
+#define AOC_NOTE_MOVE(bytes) ((void) 0)
+#endif /* AOC_ALLOC_STATS */
+
+#define AOC_NEW_DYN_ARR(type, arr_ptr, max)           \
+do                                                    \
+{                                                     \
+	(arr_ptr) = AOC_MALLOC(sizeof(type) * (max)); \
+	AOC_ASSERT((arr_ptr) != NULL);                \
 } while (0)
 
 /* Modifies both arr and len */
@@ -37,7 +73,8 @@ do                                                                      \
 	type *AOC_EXPAND_ARR;                                           \
 	size_t AOC_EXPAND_LEN = ((len) == 0) ? (2) : (((len) * 3) / 2); \
 	                                                                \
-	AOC_EXPAND_ARR = realloc((arr), sizeof(type) * AOC_EXPAND_LEN); \
+	AOC_EXPAND_ARR = AOC_REALLOC((arr),                             \
+		sizeof(type) * AOC_EXPAND_LEN);                         \
 	AOC_ASSERT(AOC_EXPAND_ARR != NULL);                             \
 	(arr) = AOC_EXPAND_ARR;                                         \
 	(len) = AOC_EXPAND_LEN;                                         \
@@ -54,6 +91,24 @@ do                                                    \
 	(arr)[(len)++] = (val);                       \
 } while (0)
 
+/* Grows arr to hold at least want elements in a single allocation, for when
+ * the count can be estimated up front. Modifies both arr and max, does
+ * nothing when there is already room */
+#define AOC_RESERVE_DYN_ARR(type, arr, max, want)                       \
+do                                                                      \
+{                                                                       \
+	const size_t AOC_RESERVE_LEN = (want);                          \
+	                                                                \
+	if ((max) < AOC_RESERVE_LEN)                                    \
+	{                                                               \
+		type *AOC_RESERVE_ARR = AOC_REALLOC((arr),              \
+			sizeof(type) * AOC_RESERVE_LEN);                \
+		AOC_ASSERT(AOC_RESERVE_ARR != NULL);                    \
+		(arr) = AOC_RESERVE_ARR;                                \
+		(max) = AOC_RESERVE_LEN;                                \
+	}                                                               \
+} while (0)
+
 /* Insertion sort concatination. Entirely possible there is a way to do this 
  * in a regular function should one prefer */
 #define AOC_INSERT_CAT(type, arr, len, max, val, CompFunc)              \
@@ -76,20 +131,22 @@ do                                                                      \
 		AOC_MEMMOVE(&((arr)[AOC_INSERT_INDEX + 1]),             \
 			&((arr)[AOC_INSERT_INDEX]),                     \
 			sizeof(type) * ((len) - AOC_INSERT_INDEX));     \
+		AOC_NOTE_MOVE(sizeof(type)                              \
+			* ((len) - AOC_INSERT_INDEX));                  \
 		(arr)[AOC_INSERT_INDEX] = (val);                        \
 		(len)++;                                                \
 	}                                                               \
 } while (0)
 
-#define AOC_FREE(ptr)         \
-do                            \
-{                             \
-	if ((ptr) != NULL)    \
-	{                     \
-		free((ptr));  \
-		(ptr) = NULL; \
-	}                     \
-} while (0)                   \
+#define AOC_FREE(ptr)             \
+do                                \
+{                                 \
+	if ((ptr) != NULL)        \
+	{                         \
+		AOC_RELEASE((ptr)); \
+		(ptr) = NULL;     \
+	}                         \
+} while (0)                       \
 
 #define AOC_SWAP(type, left, right) \
 do                                  \
@@ -112,6 +169,527 @@ do                                  \
 #define AOC_MAX(x, y) (((x) > (y)) ? (x) : (y))
 #define AOC_CLAMP(l, x, u) (AOC_MAX((l), (AOC_MIN((x), (u)))))
 
+/* Answers, and the running totals behind them, are accumulated in an AOC_ACC
+ * with the checked helpers below so that an input too large for it fails
+ * rather than printing a wrapped answer. It's a long by default, build with
+ * -DAOC_ACC_128 to widen it to 128 bits where the compiler has __int128, eg:
+ * GCC and Clang on 64 bit targets. Print one through accFormat as printf has
+ * no conversion for 128 bit integers */
+#if defined(AOC_ACC_128) && defined(__SIZEOF_INT128__)
+__extension__ typedef __int128 aocAcc128;
+__extension__ typedef unsigned __int128 aocAccUnsigned128;
+#define AOC_ACC aocAcc128
+#define AOC_ACC_UNSIGNED aocAccUnsigned128
+#else
+#define AOC_ACC long int
+#define AOC_ACC_UNSIGNED unsigned long int
+#endif /* AOC_ACC_128 && __SIZEOF_INT128__ */
+
+#define AOC_ACC_MAX ((AOC_ACC) (((AOC_ACC_UNSIGNED) -1) >> 1))
+#define AOC_ACC_MIN (-AOC_ACC_MAX - 1)
+
+/* Room for the sign, the 39 digits of a 128 bit value, and the terminator */
+#define AOC_ACC_DIGITS (41)
+
+#if defined(__GNUC__) && (__GNUC__ >= 5)
+#define AOC_ACC_HAS_BUILTINS
+#endif /* __GNUC__ */
+
+/* Both leave the accumulator as it was when the result doesn't fit */
+static AOC_STAT accAdd(AOC_ACC *sum, const AOC_ACC val)
+{
+#if defined(AOC_ACC_HAS_BUILTINS)
+	AOC_ACC tmp;
+
+	if (__builtin_add_overflow(*sum, val, &tmp))
+	{
+		return AOC_FAILURE;
+	}
+
+	*sum = tmp;
+#else
+	if (((val > 0) && (*sum > AOC_ACC_MAX - val))
+	|| ((val < 0) && (*sum < AOC_ACC_MIN - val)))
+	{
+		return AOC_FAILURE;
+	}
+
+	*sum += val;
+#endif /* AOC_ACC_HAS_BUILTINS */
+
+	return AOC_SUCCESS;
+}
+
+static AOC_STAT accSub(AOC_ACC *diff, const AOC_ACC val)
+{
+#if defined(AOC_ACC_HAS_BUILTINS)
+	AOC_ACC tmp;
+
+	if (__builtin_sub_overflow(*diff, val, &tmp))
+	{
+		return AOC_FAILURE;
+	}
+
+	*diff = tmp;
+#else
+	if (((val < 0) && (*diff > AOC_ACC_MAX + val))
+	|| ((val > 0) && (*diff < AOC_ACC_MIN + val)))
+	{
+		return AOC_FAILURE;
+	}
+
+	*diff -= val;
+#endif /* AOC_ACC_HAS_BUILTINS */
+
+	return AOC_SUCCESS;
+}
+
+static AOC_STAT accMul(AOC_ACC *prod, const AOC_ACC val)
+{
+#if defined(AOC_ACC_HAS_BUILTINS)
+	AOC_ACC tmp;
+
+	if (__builtin_mul_overflow(*prod, val, &tmp))
+	{
+		return AOC_FAILURE;
+	}
+
+	*prod = tmp;
+#else
+	const AOC_ACC left = *prod;
+
+	if ((left != 0) && (val != 0)
+	&& ((left > 0)
+		? ((val > 0) 
+			? (left > AOC_ACC_MAX / val) 
+			: (val < AOC_ACC_MIN / left))
+		: ((val > 0) 
+			? (left < AOC_ACC_MIN / val) 
+			: (val < AOC_ACC_MAX / left))))
+	{
+		return AOC_FAILURE;
+	}
+
+	*prod = left * val;
+#endif /* AOC_ACC_HAS_BUILTINS */
+
+	return AOC_SUCCESS;
+}
+
+/* Writes the value in decimal to the end of 'buf', which must hold at least
+ * AOC_ACC_DIGITS chars, and returns where the digits start */
+static const char* accFormat(const AOC_ACC val, char *buf)
+{
+	AOC_ACC_UNSIGNED mag = (val < 0) 
+		? (AOC_ACC_UNSIGNED) 0 - (AOC_ACC_UNSIGNED) val 
+		: (AOC_ACC_UNSIGNED) val;
+	char *curr = buf + AOC_ACC_DIGITS - 1;
+
+	*curr = '\0';
+
+	do
+	{
+		*--curr = (char) ('0' + (int) (mag % 10));
+		mag /= 10;
+	} while (mag != 0);
+
+	if (val < 0)
+	{
+		*--curr = '-';
+	}
+
+	return curr;
+}
+
+/* The inverse of accFormat, the whole string has to be the number */
+static AOC_STAT accParse(const char *str, AOC_ACC *out)
+{
+	const AOC_BOOL is_negative = (*str == '-');
+	AOC_ACC val = 0;
+
+	str += is_negative;
+
+	if ((*str < '0') || (*str > '9'))
+	{
+		return AOC_FAILURE;
+	}
+
+	/* Accumulated towards the sign so that the minimum can be read back */
+	for (; (*str >= '0') && (*str <= '9'); str++)
+	{
+		const AOC_ACC digit = *str - '0';
+
+		if ((accMul(&val, 10) != AOC_SUCCESS)
+		|| (accAdd(&val, (is_negative == AOC_TRUE) ? -digit : digit)
+			!= AOC_SUCCESS))
+		{
+			return AOC_FAILURE;
+		}
+	}
+
+	if (*str != '\0')
+	{
+		return AOC_FAILURE;
+	}
+
+	*out = val;
+
+	return AOC_SUCCESS;
+}
+
+#if defined(AOC_ALLOC_STATS)
+/* Allocation accounting per call site. Live blocks are remembered in an open
+ * addressing table keyed on their address so frees and reallocs can be 
+ * charged back to the site that made them, blocks that didn't come through
+ * the macros are simply never found there. The report is written to stderr
+ * at exit, a program linking several days writes one for each of them as
+ * every translation unit keeps its own tallies */
+struct aocAllocSite
+{
+	const char *file;
+	int line;
+	unsigned long int allocs;
+	unsigned long int reallocs;
+	unsigned long int realloc_moved; /* Copied by reallocs that moved */
+	unsigned long int memmoved;      /* Shifted by AOC_INSERT_CAT */
+	unsigned long int live;
+	unsigned long int peak;
+};
+
+struct aocAllocBlock
+{
+	void *ptr;
+	size_t size;
+	size_t site;
+};
+
+static struct
+{
+	struct aocAllocSite *sites;
+	size_t num_sites;
+	size_t max_sites;
+	struct aocAllocBlock *blocks; /* Power of two length, NULL ptr empty */
+	size_t num_blocks;
+	size_t max_blocks;
+	unsigned long int live;
+	unsigned long int peak;
+	AOC_BOOL is_registered;
+#if defined(AOC_USE_THREADS)
+	pthread_mutex_t lock;
+#endif /* AOC_USE_THREADS */
+} aoc_alloc_stats =
+{
+	NULL, 0, 0, NULL, 0, 0, 0, 0, AOC_FALSE
+#if defined(AOC_USE_THREADS)
+	, PTHREAD_MUTEX_INITIALIZER
+#endif /* AOC_USE_THREADS */
+};
+
+#if defined(AOC_USE_THREADS)
+#define AOC_ALLOC_STATS_LOCK() pthread_mutex_lock(&aoc_alloc_stats.lock)
+#define AOC_ALLOC_STATS_UNLOCK() pthread_mutex_unlock(&aoc_alloc_stats.lock)
+#else
+#define AOC_ALLOC_STATS_LOCK() ((void) 0)
+#define AOC_ALLOC_STATS_UNLOCK() ((void) 0)
+#endif /* AOC_USE_THREADS */
+
+static size_t allocStatsHash(const void *ptr)
+{
+	return (size_t) (((unsigned long int) ptr >> 4) * 2654435761ul)
+		& (aoc_alloc_stats.max_blocks - 1);
+}
+
+static int compareAllocSites(const void *left, const void *right)
+{
+	const struct aocAllocSite *foo = left;
+	const struct aocAllocSite *bar = right;
+	const unsigned long int foo_churn = foo->realloc_moved + foo->memmoved;
+	const unsigned long int bar_churn = bar->realloc_moved + bar->memmoved;
+
+	return (foo_churn < bar_churn) - (foo_churn > bar_churn);
+}
+
+static void allocStatsReport(void)
+{
+	size_t i;
+
+	/* Keeps the report after any answers still sitting in the buffer */
+	fflush(stdout);
+
+	AOC_ALLOC_STATS_LOCK();
+	qsort(aoc_alloc_stats.sites, aoc_alloc_stats.num_sites,
+		sizeof(struct aocAllocSite), compareAllocSites);
+	fprintf(stderr, "Allocations by call site, peak live %lu bytes\n"
+		"%-32s %8s %8s %14s %14s %12s\n", aoc_alloc_stats.peak,
+		"site", "allocs", "reallocs", "realloc_moved", "memmoved",
+		"peak_live");
+
+	for (i = 0; i < aoc_alloc_stats.num_sites; i++)
+	{
+		const struct aocAllocSite *site = &aoc_alloc_stats.sites[i];
+		const size_t file_len = strlen(site->file);
+		char name[48];
+
+		/* The end of the path is the part that tells sites apart */
+		sprintf(name, "%s:%d", (file_len > 24) 
+			? site->file + file_len - 24 
+			: site->file, site->line);
+		fprintf(stderr, "%-32s %8lu %8lu %14lu %14lu %12lu\n", name,
+			site->allocs, site->reallocs, site->realloc_moved,
+			site->memmoved, site->peak);
+	}
+
+	AOC_ALLOC_STATS_UNLOCK();
+}
+
+/* Finds or adds the entry for a call site, registering the report with the
+ * first one */
+static size_t allocStatsSite(const char *file, const int line)
+{
+	struct aocAllocSite *site = NULL;
+	size_t i;
+
+	for (i = 0; i < aoc_alloc_stats.num_sites; i++)
+	{
+		if ((aoc_alloc_stats.sites[i].line == line)
+		&& ((aoc_alloc_stats.sites[i].file == file)
+			|| (strcmp(aoc_alloc_stats.sites[i].file, file) == 0)))
+		{
+			return i;
+		}
+	}
+
+	if (aoc_alloc_stats.is_registered == AOC_FALSE)
+	{
+		atexit(allocStatsReport);
+		aoc_alloc_stats.is_registered = AOC_TRUE;
+	}
+
+	if (aoc_alloc_stats.num_sites == aoc_alloc_stats.max_sites)
+	{
+		const size_t max = (aoc_alloc_stats.max_sites == 0)
+			? 32
+			: aoc_alloc_stats.max_sites * 2;
+
+		site = realloc(aoc_alloc_stats.sites, 
+			sizeof(struct aocAllocSite) * max);
+		AOC_ASSERT(site != NULL);
+		aoc_alloc_stats.sites = site;
+		aoc_alloc_stats.max_sites = max;
+	}
+
+	site = &aoc_alloc_stats.sites[aoc_alloc_stats.num_sites];
+	memset(site, 0, sizeof(struct aocAllocSite));
+	site->file = file;
+	site->line = line;
+
+	return aoc_alloc_stats.num_sites++;
+}
+
+static void allocStatsCharge(const size_t site, const size_t size)
+{
+	struct aocAllocSite *entry = &aoc_alloc_stats.sites[site];
+
+	entry->live += size;
+	entry->peak = AOC_MAX(entry->peak, entry->live);
+	aoc_alloc_stats.live += size;
+	aoc_alloc_stats.peak = AOC_MAX(aoc_alloc_stats.peak, 
+		aoc_alloc_stats.live);
+}
+
+static void allocStatsInsert(void *ptr, const size_t size, const size_t site)
+{
+	size_t i;
+
+	/* Kept at most half full */
+	if ((aoc_alloc_stats.num_blocks + 1) * 2 > aoc_alloc_stats.max_blocks)
+	{
+		struct aocAllocBlock *old = aoc_alloc_stats.blocks;
+		const size_t old_max = aoc_alloc_stats.max_blocks;
+
+		aoc_alloc_stats.max_blocks = (old_max == 0) ? 64 : old_max * 2;
+		aoc_alloc_stats.blocks = calloc(aoc_alloc_stats.max_blocks,
+			sizeof(struct aocAllocBlock));
+		AOC_ASSERT(aoc_alloc_stats.blocks != NULL);
+		aoc_alloc_stats.num_blocks = 0;
+
+		for (i = 0; i < old_max; i++)
+		{
+			if (old[i].ptr != NULL)
+			{
+				allocStatsInsert(old[i].ptr, old[i].size, 
+					old[i].site);
+			}
+		}
+
+		free(old);
+	}
+
+	for (i = allocStatsHash(ptr); aoc_alloc_stats.blocks[i].ptr != NULL;
+		i = (i + 1) & (aoc_alloc_stats.max_blocks - 1))
+	{
+		/* A stale block that was freed outside of the macros */
+		if (aoc_alloc_stats.blocks[i].ptr == ptr)
+		{
+			const struct aocAllocBlock *stale 
+				= &aoc_alloc_stats.blocks[i];
+
+			aoc_alloc_stats.sites[stale->site].live -= stale->size;
+			aoc_alloc_stats.live -= stale->size;
+			aoc_alloc_stats.num_blocks--;
+
+			break;
+		}
+	}
+
+	aoc_alloc_stats.blocks[i].ptr = ptr;
+	aoc_alloc_stats.blocks[i].size = size;
+	aoc_alloc_stats.blocks[i].site = site;
+	aoc_alloc_stats.num_blocks++;
+}
+
+/* Removes the block, returning AOC_FALSE if it was never recorded */
+static AOC_BOOL allocStatsRemove(void *ptr, struct aocAllocBlock *out)
+{
+	const size_t mask = aoc_alloc_stats.max_blocks - 1;
+	size_t i, j;
+
+	if ((ptr == NULL) || (aoc_alloc_stats.max_blocks == 0))
+	{
+		return AOC_FALSE;
+	}
+
+	for (i = allocStatsHash(ptr); aoc_alloc_stats.blocks[i].ptr != ptr;
+		i = (i + 1) & mask)
+	{
+		if (aoc_alloc_stats.blocks[i].ptr == NULL)
+		{
+			return AOC_FALSE;
+		}
+	}
+
+	*out = aoc_alloc_stats.blocks[i];
+	aoc_alloc_stats.num_blocks--;
+
+	/* Shift later members of the probe run back over the hole so that
+	 * lookups never stop short of them */
+	for (j = (i + 1) & mask; aoc_alloc_stats.blocks[j].ptr != NULL;
+		j = (j + 1) & mask)
+	{
+		const size_t home = allocStatsHash(aoc_alloc_stats.blocks[j].ptr);
+
+		if (((j > i) && ((home <= i) || (home > j)))
+		|| ((j < i) && (home <= i) && (home > j)))
+		{
+			aoc_alloc_stats.blocks[i] = aoc_alloc_stats.blocks[j];
+			i = j;
+		}
+	}
+
+	aoc_alloc_stats.blocks[i].ptr = NULL;
+
+	return AOC_TRUE;
+}
+
+static void allocStatsRelease(void *ptr)
+{
+	struct aocAllocBlock block;
+
+	if (allocStatsRemove(ptr, &block) == AOC_TRUE)
+	{
+		aoc_alloc_stats.sites[block.site].live -= block.size;
+		aoc_alloc_stats.live -= block.size;
+	}
+}
+
+static void* allocStatsMalloc(const size_t size, const char *file, 
+	const int line)
+{
+	void *ptr = malloc(size);
+	size_t site;
+
+	AOC_ALLOC_STATS_LOCK();
+	site = allocStatsSite(file, line);
+	aoc_alloc_stats.sites[site].allocs++;
+
+	if (ptr != NULL)
+	{
+		allocStatsInsert(ptr, size, site);
+		allocStatsCharge(site, size);
+	}
+
+	AOC_ALLOC_STATS_UNLOCK();
+
+	return ptr;
+}
+
+/* The new size is charged to the resizing site, the old to whichever site
+ * last held the block */
+static void* allocStatsRealloc(void *ptr, const size_t size, 
+	const char *file, const int line)
+{
+	struct aocAllocBlock old = {0};
+	void *new_ptr = NULL;
+	AOC_BOOL is_known;
+	size_t site;
+
+	AOC_ALLOC_STATS_LOCK();
+	is_known = allocStatsRemove(ptr, &old);
+	AOC_ALLOC_STATS_UNLOCK();
+
+	new_ptr = realloc(ptr, size);
+
+	AOC_ALLOC_STATS_LOCK();
+	site = allocStatsSite(file, line);
+	aoc_alloc_stats.sites[site].reallocs++;
+
+	if (new_ptr == NULL)
+	{
+		if (is_known == AOC_TRUE)
+		{
+			allocStatsInsert(ptr, old.size, old.site);
+		}
+	}
+	else
+	{
+		if (is_known == AOC_TRUE)
+		{
+			aoc_alloc_stats.sites[old.site].live -= old.size;
+			aoc_alloc_stats.live -= old.size;
+		}
+
+		if ((ptr != NULL) && (new_ptr != ptr))
+		{
+			aoc_alloc_stats.sites[site].realloc_moved
+				+= AOC_MIN(old.size, size);
+		}
+
+		allocStatsInsert(new_ptr, size, site);
+		allocStatsCharge(site, size);
+	}
+
+	AOC_ALLOC_STATS_UNLOCK();
+
+	return new_ptr;
+}
+
+static void allocStatsFree(void *ptr)
+{
+	AOC_ALLOC_STATS_LOCK();
+	allocStatsRelease(ptr);
+	AOC_ALLOC_STATS_UNLOCK();
+	free(ptr);
+}
+
+static void allocStatsMove(const size_t bytes, const char *file, 
+	const int line)
+{
+	AOC_ALLOC_STATS_LOCK();
+	aoc_alloc_stats.sites[allocStatsSite(file, line)].memmoved += bytes;
+	AOC_ALLOC_STATS_UNLOCK();
+}
+#endif /* AOC_ALLOC_STATS */
+
 /* These binary search variant functions are here just because while the 
  * standard library does include bsearch its behavior is undefined for what
  * element it returns if the target element appears more than once. These 
@@ -174,28 +752,2547 @@ static size_t rightBinSearch(void *arr, const size_t len, const void *target,
 	return right - 1;
 }
 
-static long int getFileLength(FILE *f_handle)
+/* Sorts instantiated per element type so that keys and comparisons are
+ * inlined rather than called through a function pointer like qsort's. Each
+ * macro expands to static functions named from 'Name', so they are meant to
+ * be used at file scope in the translation unit needing them */
+
+/* Order preserving unsigned key for a signed int, for use as a radix key */
+#define AOC_RADIX_INT_KEY(val)                    \
+	((unsigned long int) ((unsigned int) (val) \
+		^ ((unsigned int) INT_MAX + 1u)))
+
+/* LSD radix sort over the low 'key_bytes' bytes of the unsigned long key
+ * that KeyOf(element) gives, AOC_RADIX_BITS at a time. The digit counts for
+ * every pass are gathered in a single pass up front, as moving elements
+ * around doesn't change them, and passes where every element has the same
+ * digit are skipped, so narrow keys in a wide type cost little. It is
+ * stable, so a pair of keys can be sorted by sorting on the minor key and
+ * then the major one:
+ *
+ * AOC_DEFINE_RADIX_SORT(sortInts, int, AOC_RADIX_INT_KEY, sizeof(int))
+ * sortInts(arr, len); */
+#ifndef AOC_RADIX_BITS
+#define AOC_RADIX_BITS (11)
+#endif /* AOC_RADIX_BITS */
+
+#define AOC_RADIX_BUCKETS (1ul << AOC_RADIX_BITS)
+#define AOC_RADIX_PASSES(key_bytes) \
+	((((key_bytes) * CHAR_BIT) + AOC_RADIX_BITS - 1) / AOC_RADIX_BITS)
+#define AOC_RADIX_DIGIT(key, pass) \
+	(((key) >> ((pass) * AOC_RADIX_BITS)) & (AOC_RADIX_BUCKETS - 1))
+
+#define AOC_DEFINE_RADIX_SORT(Name, type, KeyOf, key_bytes)                 \
+static void Name(type *arr, const size_t len)                               \
+{                                                                           \
+	size_t counts[AOC_RADIX_PASSES(key_bytes)][AOC_RADIX_BUCKETS];      \
+	type *tmp = NULL;                                                   \
+	type *from = arr;                                                   \
+	type *to = NULL;                                                    \
+	size_t pass, i;                                                     \
+	                                                                    \
+	if (len < 2)                                                        \
+	{                                                                   \
+		return;                                                     \
+	}                                                                   \
+	                                                                    \
+	memset(counts, 0, sizeof(counts));                                  \
+	                                                                    \
+	for (i = 0; i < len; i++)                                           \
+	{                                                                   \
+		const unsigned long int key = KeyOf(arr[i]);                \
+		                                                            \
+		for (pass = 0; pass < AOC_RADIX_PASSES(key_bytes); pass++)  \
+		{                                                           \
+			counts[pass][AOC_RADIX_DIGIT(key, pass)]++;         \
+		}                                                           \
+	}                                                                   \
+	                                                                    \
+	AOC_NEW_DYN_ARR(type, tmp, len);                                    \
+	to = tmp;                                                           \
+	                                                                    \
+	for (pass = 0; pass < AOC_RADIX_PASSES(key_bytes); pass++)          \
+	{                                                                   \
+		size_t *offsets = counts[pass];                             \
+		size_t total = 0;                                           \
+		                                                            \
+		if (offsets[AOC_RADIX_DIGIT(KeyOf(arr[0]), pass)] == len)   \
+		{                                                           \
+			continue;                                           \
+		}                                                           \
+		                                                            \
+		for (i = 0; i < AOC_RADIX_BUCKETS; i++)                     \
+		{                                                           \
+			const size_t count = offsets[i];                    \
+			                                                    \
+			offsets[i] = total;                                 \
+			total += count;                                     \
+		}                                                           \
+		                                                            \
+		for (i = 0; i < len; i++)                                   \
+		{                                                           \
+			to[offsets[AOC_RADIX_DIGIT(KeyOf(from[i]), pass)]++] \
+				= from[i];                                  \
+		}                                                           \
+		                                                            \
+		AOC_SWAP(type *, from, to);                                 \
+	}                                                                   \
+	                                                                    \
+	if (from != arr)                                                    \
+	{                                                                   \
+		memcpy(arr, from, sizeof(type) * len);                      \
+	}                                                                   \
+	                                                                    \
+	AOC_FREE(tmp);                                                      \
+}
+
+#ifndef AOC_INTRO_SORT_CUTOFF
+#define AOC_INTRO_SORT_CUTOFF (16)
+#endif /* AOC_INTRO_SORT_CUTOFF */
+
+/* Introsort, a median of three quicksort that falls back to heapsort once
+ * the recursion gets deeper than twice the log of the length, finishing
+ * short ranges with insertion sort. LessThan(a, b) is given two elements
+ * and should be a macro so that it is inlined:
+ *
+ * #define RULE_LESS(a, b) ((a).left < (b).left)
+ * AOC_DEFINE_INTRO_SORT(sortRules, struct pageRule, RULE_LESS)
+ * sortRules(arr, len); */
+#define AOC_DEFINE_INTRO_SORT(Name, type, LessThan)                         \
+static void Name##Insertion(type *arr, const size_t len)                    \
+{                                                                           \
+	size_t i, j;                                                        \
+	                                                                    \
+	for (i = 1; i < len; i++)                                           \
+	{                                                                   \
+		type tmp = arr[i];                                          \
+		                                                            \
+		for (j = i; (j > 0) && (LessThan(tmp, arr[j - 1])); j--)    \
+		{                                                           \
+			arr[j] = arr[j - 1];                                \
+		}                                                           \
+		                                                            \
+		arr[j] = tmp;                                               \
+	}                                                                   \
+}                                                                           \
+                                                                            \
+static void Name##SiftDown(type *arr, size_t root, const size_t len)        \
+{                                                                           \
+	for (;;)                                                            \
+	{                                                                   \
+		size_t child = (root * 2) + 1;                              \
+		                                                            \
+		if (child >= len)                                           \
+		{                                                           \
+			break;                                              \
+		}                                                           \
+		                                                            \
+		if ((child + 1 < len) && (LessThan(arr[child],              \
+			arr[child + 1])))                                   \
+		{                                                           \
+			child++;                                            \
+		}                                                           \
+		                                                            \
+		if (!(LessThan(arr[root], arr[child])))                     \
+		{                                                           \
+			break;                                              \
+		}                                                           \
+		                                                            \
+		AOC_SWAP(type, arr[root], arr[child]);                      \
+		root = child;                                               \
+	}                                                                   \
+}                                                                           \
+                                                                            \
+static void Name##Heap(type *arr, const size_t len)                         \
+{                                                                           \
+	size_t i;                                                           \
+	                                                                    \
+	for (i = len / 2; i-- > 0;)                                         \
+	{                                                                   \
+		Name##SiftDown(arr, i, len);                                \
+	}                                                                   \
+	                                                                    \
+	for (i = len; i-- > 1;)                                             \
+	{                                                                   \
+		AOC_SWAP(type, arr[0], arr[i]);                             \
+		Name##SiftDown(arr, 0, i);                                  \
+	}                                                                   \
+}                                                                           \
+                                                                            \
+/* Recurses into the smaller side of each partition and loops on the       \
+ * larger so the stack stays logarithmic even before the depth limit */     \
+static void Name##Loop(type *arr, size_t len, size_t depth)                 \
+{                                                                           \
+	while (len > AOC_INTRO_SORT_CUTOFF)                                 \
+	{                                                                   \
+		const size_t mid = (len - 1) / 2;                           \
+		size_t left = 0;                                            \
+		size_t right = len - 1;                                     \
+		type pivot;                                                 \
+		                                                            \
+		if (depth-- == 0)                                           \
+		{                                                           \
+			Name##Heap(arr, len);                               \
+			                                                    \
+			return;                                             \
+		}                                                           \
+		                                                            \
+		if (LessThan(arr[mid], arr[0]))                             \
+		{                                                           \
+			AOC_SWAP(type, arr[mid], arr[0]);                   \
+		}                                                           \
+		                                                            \
+		if (LessThan(arr[len - 1], arr[mid]))                       \
+		{                                                           \
+			AOC_SWAP(type, arr[len - 1], arr[mid]);             \
+			                                                    \
+			if (LessThan(arr[mid], arr[0]))                     \
+			{                                                   \
+				AOC_SWAP(type, arr[mid], arr[0]);           \
+			}                                                   \
+		}                                                           \
+		                                                            \
+		/* Hoare partition, the median of three bounds both scans */\
+		pivot = arr[mid];                                           \
+		                                                            \
+		for (;;)                                                    \
+		{                                                           \
+			while (LessThan(arr[left], pivot))                  \
+			{                                                   \
+				left++;                                     \
+			}                                                   \
+			                                                    \
+			while (LessThan(pivot, arr[right]))                 \
+			{                                                   \
+				right--;                                    \
+			}                                                   \
+			                                                    \
+			if (left >= right)                                  \
+			{                                                   \
+				break;                                      \
+			}                                                   \
+			                                                    \
+			AOC_SWAP(type, arr[left], arr[right]);              \
+			left++;                                             \
+			right--;                                            \
+		}                                                           \
+		                                                            \
+		if (right + 1 < len - (right + 1))                          \
+		{                                                           \
+			Name##Loop(arr, right + 1, depth);                  \
+			arr += right + 1;                                   \
+			len -= right + 1;                                   \
+		}                                                           \
+		else                                                        \
+		{                                                           \
+			Name##Loop(arr + right + 1, len - (right + 1),      \
+				depth);                                     \
+			len = right + 1;                                    \
+		}                                                           \
+	}                                                                   \
+	                                                                    \
+	Name##Insertion(arr, len);                                          \
+}                                                                           \
+                                                                            \
+static void Name(type *arr, const size_t len)                               \
+{                                                                           \
+	size_t depth = 0;                                                   \
+	size_t i;                                                           \
+	                                                                    \
+	for (i = len; i > 1; i >>= 1)                                       \
+	{                                                                   \
+		depth += 2;                                                 \
+	}                                                                   \
+	                                                                    \
+	Name##Loop(arr, len, depth);                                        \
+}
+
+#if defined(__GNUC__)
+#define AOC_PREFETCH(addr) __builtin_prefetch((addr))
+#else
+#define AOC_PREFETCH(addr) ((void) 0)
+#endif /* __GNUC__ */
+
+/* Typed counterparts of leftBinSearch with the comparison inlined, for
+ * sorted arrays on hot paths. LessThan(a, b) is given two elements as with
+ * AOC_DEFINE_INTRO_SORT */
+
+/* Branchless lower bound, returns the index of the first element that isn't
+ * less than key or len when there is none. The loop only narrows the range so
+ * the compiler can select the new base with a conditional move instead of a
+ * branch that mispredicts half of the time */
+#define AOC_DEFINE_LOWER_BOUND(Name, type, LessThan)                        \
+static size_t Name(const type *arr, const size_t len, const type key)       \
+{                                                                           \
+	const type *base = arr;                                             \
+	size_t num = len;                                                   \
+	                                                                    \
+	if (len == 0)                                                       \
+	{                                                                   \
+		return 0;                                                   \
+	}                                                                   \
+	                                                                    \
+	while (num > 1)                                                     \
+	{                                                                   \
+		const size_t half = num / 2;                                \
+		                                                            \
+		base = (LessThan(base[half], key)) ? base + half : base;    \
+		num -= half;                                                \
+	}                                                                   \
+	                                                                    \
+	return (base - arr) + ((LessThan(*base, key)) ? 1 : 0);             \
+}
+
+/* Elements ahead of the current node that are prefetched, the sixteen
+ * descendants four levels down share a cache line when they are ints */
+#ifndef AOC_EYTZINGER_PREFETCH_LEN
+#define AOC_EYTZINGER_PREFETCH_LEN (16)
+#endif /* AOC_EYTZINGER_PREFETCH_LEN */
+
+/* Eytzinger layout search for sorted arrays that are only ever read.
+ * Name##Build copies 'len' sorted elements into 'tree', which needs len + 1
+ * slots as it is indexed from one, laid out as an implicit binary tree in
+ * breadth first order. The children of node k are 2k and 2k + 1 so a search
+ * walks memory in a predictable way and the next few levels can be
+ * prefetched. Name##LowerBound returns the tree index of the first element
+ * that isn't less than key, zero when there is none */
+#define AOC_DEFINE_EYTZINGER(Name, type, LessThan)                          \
+static size_t Name##Fill(const type *sorted, type *tree, size_t next,       \
+	const size_t node, const size_t len)                                \
+{                                                                           \
+	if (node <= len)                                                    \
+	{                                                                   \
+		next = Name##Fill(sorted, tree, next, node * 2, len);       \
+		tree[node] = sorted[next++];                                \
+		next = Name##Fill(sorted, tree, next, (node * 2) + 1, len); \
+	}                                                                   \
+	                                                                    \
+	return next;                                                        \
+}                                                                           \
+                                                                            \
+static void Name##Build(const type *sorted, type *tree, const size_t len)   \
+{                                                                           \
+	Name##Fill(sorted, tree, 0, 1, len);                                \
+}                                                                           \
+                                                                            \
+static size_t Name##LowerBound(const type *tree, const size_t len,          \
+	const type key)                                                     \
+{                                                                           \
+	size_t node = 1;                                                    \
+	                                                                    \
+	while (node <= len)                                                 \
+	{                                                                   \
+		AOC_PREFETCH(tree + (node * AOC_EYTZINGER_PREFETCH_LEN));   \
+		node = (node * 2) + ((LessThan(tree[node], key)) ? 1 : 0);  \
+	}                                                                   \
+	                                                                    \
+	/* Undo the right turns taken after the last left one, that left    \
+	 * turn was at the answer */                                        \
+	while ((node & 1) != 0)                                             \
+	{                                                                   \
+		node >>= 1;                                                 \
+	}                                                                   \
+	                                                                    \
+	return node >> 1;                                                   \
+}
+
+/* Open addressing hash table of integer keys with linear probing, for
+ * membership tests that would otherwise keep a sorted array. Slots are live
+ * only when their stamp matches the table's generation, so clearing is a
+ * counter bump rather than a pass over the slots, which is what searches
+ * that restart many times over want. Keys of grid cells are simply their
+ * AOC_GRID_OFFSET. Maps also carry a value per slot, sets leave vals NULL */
+
+#ifndef AOC_HASH_MIN_LEN
+#define AOC_HASH_MIN_LEN (16)
+#endif /* AOC_HASH_MIN_LEN */
+
+struct aocHash
 {
-	long int length = -1;
+	unsigned long int *keys;
+	unsigned long int *stamps;
+	long int *vals;
+	size_t len;
+	size_t max; /* Always a power of two, kept at most half full */
+	unsigned long int generation;
+};
 
-	if (f_handle != NULL)
-	{
-		const long int initial = ftell(f_handle);
+#define AOC_HASH_KEY(val) ((unsigned long int) (val))
 
-		if (fseek(f_handle, 0, SEEK_END) == -1)
-		{
-			return -1;
-		}
+static size_t hashSlot(const struct aocHash *hash, unsigned long int key)
+{
+	key ^= key >> 16;
+	key *= 0x45D9F3Bul;
+	key ^= key >> 16;
 
-		length = ftell(f_handle);
+	return key & (hash->max - 1);
+}
 
-		if (fseek(f_handle, initial, SEEK_SET) == -1)
-		{
-			return -1;
-		}
+static void hashAlloc(struct aocHash *hash, const size_t max, 
+	const AOC_BOOL has_vals)
+{
+	hash->keys = AOC_MALLOC(sizeof(unsigned long int) * max);
+	hash->stamps = AOC_MALLOC(sizeof(unsigned long int) * max);
+	hash->vals = (has_vals == AOC_TRUE) 
+		? AOC_MALLOC(sizeof(long int) * max)
+		: NULL;
+	AOC_ASSERT((hash->keys != NULL) && (hash->stamps != NULL)
+		&& ((has_vals == AOC_FALSE) || (hash->vals != NULL)));
+	memset(hash->stamps, 0, sizeof(unsigned long int) * max);
+	hash->max = max;
+	hash->len = 0;
+	hash->generation = 1;
+}
+
+/* Sized so that 'expected' keys fit without growing */
+static void hashInit(struct aocHash *hash, const size_t expected,
+	const AOC_BOOL has_vals)
+{
+	size_t max = AOC_HASH_MIN_LEN;
+
+	while (max / 2 < expected)
+	{
+		max <<= 1;
 	}
 
-	return length;
+	hashAlloc(hash, max, has_vals);
+}
+
+static void hashFree(struct aocHash *hash)
+{
+	if (hash != NULL)
+	{
+		AOC_FREE(hash->keys);
+		AOC_FREE(hash->stamps);
+		AOC_FREE(hash->vals);
+		hash->len = 0;
+		hash->max = 0;
+	}
+}
+
+static void hashClear(struct aocHash *hash)
+{
+	hash->len = 0;
+
+	/* Only once the counter wraps do the stamps need resetting */
+	if (++hash->generation == 0)
+	{
+		memset(hash->stamps, 0, sizeof(unsigned long int) * hash->max);
+		hash->generation = 1;
+	}
+}
+
+/* Returns AOC_TRUE when the key is present. Either way 'slot' is set to where
+ * it is or where it would be inserted */
+static AOC_BOOL hashFind(const struct aocHash *hash, 
+	const unsigned long int key, size_t *slot)
+{
+	size_t i = hashSlot(hash, key);
+
+	while (hash->stamps[i] == hash->generation)
+	{
+		if (hash->keys[i] == key)
+		{
+			*slot = i;
+
+			return AOC_TRUE;
+		}
+
+		i = (i + 1) & (hash->max - 1);
+	}
+
+	*slot = i;
+
+	return AOC_FALSE;
+}
+
+static void hashGrow(struct aocHash *hash)
+{
+	struct aocHash old = *hash;
+	size_t i;
+
+	hashAlloc(hash, old.max * 2, (old.vals != NULL));
+
+	for (i = 0; i < old.max; i++)
+	{
+		size_t slot;
+
+		if (old.stamps[i] != old.generation)
+		{
+			continue;
+		}
+
+		hashFind(hash, old.keys[i], &slot);
+		hash->keys[slot] = old.keys[i];
+		hash->stamps[slot] = hash->generation;
+
+		if (old.vals != NULL)
+		{
+			hash->vals[slot] = old.vals[i];
+		}
+
+		hash->len++;
+	}
+
+	hashFree(&old);
+}
+
+/* Returns AOC_TRUE if the key was newly added and AOC_FALSE if it was already
+ * present. When 'slot' isn't NULL it is set to the key's slot so that a map
+ * can reach the value, which is left for the caller to set on insertion */
+static AOC_BOOL hashInsert(struct aocHash *hash, const unsigned long int key,
+	size_t *slot)
+{
+	size_t i;
+
+	if ((hash->len + 1) * 2 > hash->max)
+	{
+		hashGrow(hash);
+	}
+
+	if (hashFind(hash, key, &i) == AOC_TRUE)
+	{
+		if (slot != NULL)
+		{
+			*slot = i;
+		}
+
+		return AOC_FALSE;
+	}
+
+	hash->keys[i] = key;
+	hash->stamps[i] = hash->generation;
+	hash->len++;
+
+	if (slot != NULL)
+	{
+		*slot = i;
+	}
+
+	return AOC_TRUE;
+}
+
+/* Bump allocator, allocations are carved out of large blocks and can only be
+ * released all at once by either resetting or destroying the arena. This
+ * keeps related data, like the rows of a grid, contiguous in memory and turns
+ * teardown into a handful of frees instead of one per allocation */
+
+#ifndef AOC_ARENA_BLOCK_LEN
+#define AOC_ARENA_BLOCK_LEN (64 * 1024)
+#endif /* AOC_ARENA_BLOCK_LEN */
+
+/* C89 has no max_align_t so this is the next best thing */
+union aocMaxAlign
+{
+	long int l;
+	double d;
+	long double ld;
+	void *p;
+	void (*f)(void);
+};
+
+#define AOC_ARENA_ALIGN (sizeof(union aocMaxAlign))
+
+struct aocArenaBlock
+{
+	struct aocArenaBlock *next;
+	size_t used;
+	size_t size;
+	union aocMaxAlign data[1]; /* Block storage starts here */
+};
+
+struct aocArena
+{
+	struct aocArenaBlock *head; /* Block currently being bumped */
+	struct aocArenaBlock *first; /* Kept across resets */
+	size_t block_size;
+};
+
+static struct aocArenaBlock* newArenaBlock(const size_t size)
+{
+	struct aocArenaBlock *block = malloc(sizeof(struct aocArenaBlock)
+		+ size);
+
+	if (block != NULL)
+	{
+		block->next = NULL;
+		block->used = 0;
+		block->size = size;
+	}
+
+	return block;
+}
+
+static struct aocArena* arenaCreate(const size_t block_size)
+{
+	struct aocArena *arena = malloc(sizeof(struct aocArena));
+
+	if (arena == NULL)
+	{
+		return NULL;
+	}
+
+	arena->block_size = (block_size == 0)
+		? AOC_ARENA_BLOCK_LEN
+		: block_size;
+
+	if ((arena->head = newArenaBlock(arena->block_size)) == NULL)
+	{
+		AOC_FREE(arena);
+
+		return NULL;
+	}
+
+	arena->first = arena->head;
+
+	return arena;
+}
+
+/* Align must be a power of two, zero sized allocations are permitted and
+ * return a unique pointer just like any other */
+static void* arenaAlloc(struct aocArena *arena, const size_t size,
+	const size_t align)
+{
+	struct aocArenaBlock *block = NULL;
+	size_t offset;
+
+	AOC_ASSERT((arena != NULL) && (align != 0)
+		&& ((align & (align - 1)) == 0));
+
+	block = arena->head;
+	offset = (size_t) ((char *) block->data + block->used) & (align - 1);
+	offset = (offset == 0) ? block->used : block->used + (align - offset);
+
+	if ((offset <= block->size) && (size <= block->size - offset))
+	{
+		block->used = offset + size;
+
+		return (char *) block->data + offset;
+	}
+
+	/* Oversized requests get a block to themselves which is spliced in
+	 * behind the head so the remainder of the current block isn't lost */
+	if (size + align > arena->block_size)
+	{
+		struct aocArenaBlock *big = newArenaBlock(size + align);
+
+		if (big == NULL)
+		{
+			return NULL;
+		}
+
+		offset = (size_t) big->data & (align - 1);
+		offset = (offset == 0) ? 0 : align - offset;
+		big->used = big->size;
+		big->next = block->next;
+		block->next = big;
+
+		return (char *) big->data + offset;
+	}
+
+	if ((block = newArenaBlock(arena->block_size)) == NULL)
+	{
+		return NULL;
+	}
+
+	block->next = arena->head;
+	arena->head = block;
+
+	return arenaAlloc(arena, size, align);
+}
+
+#define AOC_ARENA_NEW(type, arena, count) \
+	((type *) arenaAlloc((arena), sizeof(type) * (count), AOC_ARENA_ALIGN))
+
+/* Releases every block except for the original one which is rewound so the
+ * arena can be reused without going back to malloc. Oversized blocks can be
+ * spliced in behind it so it isn't necessarily the last in the chain */
+static void arenaReset(struct aocArena *arena)
+{
+	if (arena != NULL)
+	{
+		struct aocArenaBlock *block = arena->head;
+
+		while (block != NULL)
+		{
+			struct aocArenaBlock *next = block->next;
+
+			if (block != arena->first)
+			{
+				free(block);
+			}
+
+			block = next;
+		}
+
+		arena->first->next = NULL;
+		arena->first->used = 0;
+		arena->head = arena->first;
+	}
+}
+
+static void arenaDestroy(struct aocArena *arena)
+{
+	if (arena != NULL)
+	{
+		arenaReset(arena);
+		free(arena->head);
+		free(arena);
+	}
+}
+
+static long int getFileLength(FILE *f_handle)
+{
+	long int length = -1;
+
+	if (f_handle != NULL)
+	{
+		const long int initial = ftell(f_handle);
+
+		if (fseek(f_handle, 0, SEEK_END) == -1)
+		{
+			return -1;
+		}
+
+		length = ftell(f_handle);
+
+		if (fseek(f_handle, initial, SEEK_SET) == -1)
+		{
+			return -1;
+		}
+	}
+
+	return length;
+}
+
+/* Read-only view of an entire input. Files are memory mapped when that is
+ * available and otherwise, or for pipes and stdin, slurped into a single 
+ * buffer. In both cases data[len] is a readable null terminator so the
+ * standard string functions can be used on the view without copying it.
+ * The caller also says how many threads a day may spend solving the view,
+ * so that days run side by side don't each claim every processor */
+struct aocView
+{
+	const char *data;
+	size_t len;
+	char *owned; /* Slurped buffer, NULL when the view is mapped */
+	size_t num_threads; /* At least 1, the calling thread included */
+};
+
+#ifndef AOC_SLURP_CHUNK_LEN
+#define AOC_SLURP_CHUNK_LEN (64 * 1024)
+#endif /* AOC_SLURP_CHUNK_LEN */
+
+/* Reads until the end of the stream, the file length is only used as a hint
+ * so this works just as well on pipes where it isn't available */
+static AOC_STAT viewFromStream(FILE *input, struct aocView *view)
+{
+	const long int f_len = getFileLength(input);
+	size_t max = (f_len > 0) ? (size_t) f_len + 1 : AOC_SLURP_CHUNK_LEN;
+	size_t len = 0;
+	char *buffer = NULL;
+
+	if ((input == NULL) || (view == NULL))
+	{
+		return AOC_FAILURE;
+	}
+
+	AOC_NEW_DYN_ARR(char, buffer, max);
+
+	for (;;)
+	{
+		int ch;
+
+		len += fread(buffer + len, sizeof(char), max - len - 1, input);
+
+		/* Probe for more input before growing so that a buffer sized 
+		 * from the file length never needs to be reallocated */
+		if ((len + 1 < max) || ((ch = getc(input)) == EOF))
+		{
+			break;
+		}
+
+		AOC_GROW_DYN_ARR(char, buffer, max);
+		buffer[len++] = ch;
+	}
+
+	if (ferror(input))
+	{
+		AOC_FREE(buffer);
+
+		return AOC_FAILURE;
+	}
+
+	buffer[len] = '\0';
+	view->data = buffer;
+	view->len = len;
+	view->owned = buffer;
+
+	return AOC_SUCCESS;
+}
+
+#if defined(AOC_USE_MMAP)
+/* Only maps regular files whose length isn't a multiple of the page size, the
+ * remainder of the final page is then guaranteed to be zero filled which
+ * provides the null terminator for free. Anything else falls back on 
+ * slurping */
+static AOC_STAT viewMap(const char *path, struct aocView *view)
+{
+	const long int page_len = sysconf(_SC_PAGESIZE);
+	struct stat info;
+	void *mapped;
+	int fd;
+
+	if ((fd = open(path, O_RDONLY)) == -1)
+	{
+		return AOC_FAILURE;
+	}
+
+	if ((fstat(fd, &info) == -1)
+	|| (!S_ISREG(info.st_mode))
+	|| (info.st_size == 0)
+	|| (page_len <= 0)
+	|| ((info.st_size % page_len) == 0))
+	{
+		close(fd);
+
+		return AOC_FAILURE;
+	}
+
+	mapped = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+
+	if (mapped == MAP_FAILED)
+	{
+		return AOC_FAILURE;
+	}
+
+	posix_madvise(mapped, info.st_size, POSIX_MADV_SEQUENTIAL);
+	view->data = mapped;
+	view->len = info.st_size;
+	view->owned = NULL;
+
+	return AOC_SUCCESS;
+}
+#endif /* AOC_USE_MMAP */
+
+/* The path "-" stands for stdin */
+#define AOC_IS_STDIN_PATH(path) (strcmp((path), "-") == 0)
+
+/* Opens the input at path, a path of "-" reads all of stdin instead so that
+ * inputs can be piped in. That can only be done once per run */
+static AOC_STAT viewOpen(const char *path, struct aocView *view)
+{
+	FILE *input = NULL;
+	AOC_STAT ret;
+
+	if ((path == NULL) || (view == NULL))
+	{
+		return AOC_FAILURE;
+	}
+
+	view->num_threads = 1;
+
+	if (AOC_IS_STDIN_PATH(path))
+	{
+		return viewFromStream(stdin, view);
+	}
+
+#if defined(AOC_USE_MMAP)
+	if (viewMap(path, view) == AOC_SUCCESS)
+	{
+		return AOC_SUCCESS;
+	}
+#endif /* AOC_USE_MMAP */
+
+	if ((input = fopen(path, "rb")) == NULL)
+	{
+		return AOC_FAILURE;
+	}
+
+	ret = viewFromStream(input, view);
+	fclose(input);
+
+	return ret;
+}
+
+static void viewClose(struct aocView *view)
+{
+	if (view != NULL)
+	{
+#if defined(AOC_USE_MMAP)
+		if ((view->owned == NULL) && (view->data != NULL))
+		{
+			munmap((void *) view->data, view->len);
+		}
+#endif /* AOC_USE_MMAP */
+
+		AOC_FREE(view->owned);
+		view->data = NULL;
+		view->len = 0;
+	}
+}
+
+/* Steps through the view one line at a time starting from cursor, which
+ * should initially be zero. The line is not null terminated and excludes the
+ * newline as well as any carriage return preceding it. There is no limit on 
+ * line length */
+static AOC_BOOL viewNextLine(const struct aocView *view, size_t *cursor, 
+	const char **line, size_t *line_len)
+{
+	const char *start;
+	const char *end;
+
+	if (*cursor >= view->len)
+	{
+		return AOC_FALSE;
+	}
+
+	start = view->data + *cursor;
+
+	if ((end = memchr(start, '\n', view->len - *cursor)) == NULL)
+	{
+		end = view->data + view->len;
+		*cursor = view->len;
+	}
+	else
+	{
+		*cursor = (end - view->data) + 1;
+	}
+
+	if ((end > start) && (end[-1] == '\r'))
+	{
+		end--;
+	}
+
+	*line = start;
+	*line_len = end - start;
+
+	return AOC_TRUE;
+}
+
+#ifndef AOC_ESTIMATE_SAMPLE_LEN
+#define AOC_ESTIMATE_SAMPLE_LEN (16 * 1024)
+#endif /* AOC_ESTIMATE_SAMPLE_LEN */
+
+/* Estimates how many lines lie between the offsets start and end from the
+ * density of newlines in a sample at the front of the range, which is exact
+ * for short inputs. Loaders size their arrays from this so that uniform
+ * records are stored without ever growing. A sixteenth is added as slack for
+ * lines that run a little shorter than the sampled ones */
+static size_t viewEstimateLines(const struct aocView *view, size_t start,
+	size_t end)
+{
+	const char *pos = NULL;
+	const char *sample_end = NULL;
+	size_t sample_len;
+	size_t newlines = 0;
+	size_t estimate;
+
+	end = AOC_MIN(end, view->len);
+
+	if (start >= end)
+	{
+		return 0;
+	}
+
+	sample_len = AOC_MIN(end - start, AOC_ESTIMATE_SAMPLE_LEN);
+	pos = view->data + start;
+	sample_end = pos + sample_len;
+
+	while ((pos = memchr(pos, '\n', sample_end - pos)) != NULL)
+	{
+		newlines++;
+		pos++;
+	}
+
+	if (sample_len == end - start)
+	{
+		return newlines + 1;
+	}
+
+	if (newlines == 0)
+	{
+		return 1;
+	}
+
+	/* Split so the product can't overflow on very large views */
+	estimate = (((end - start) / sample_len) * newlines)
+		+ ((((end - start) % sample_len) * newlines) / sample_len) + 1;
+
+	return estimate + (estimate / 16);
+}
+
+/* Cursor based scanning of values straight out of a view, or a single line
+ * of one. Nothing here reads at or past 'end' and on failure the cursor is
+ * left untouched so that an alternative can be tried from the same spot */
+struct aocCursor
+{
+	const char *pos;
+	const char *end;
+};
+
+#define AOC_IS_DIGIT(ch) ((unsigned int) ((ch) - '0') < 10u)
+
+static void cursorInit(struct aocCursor *curs, const char *start, 
+	const size_t len)
+{
+	curs->pos = start;
+	curs->end = start + len;
+}
+
+static void scanSkipSpace(struct aocCursor *curs)
+{
+	while ((curs->pos < curs->end) 
+	&& ((*curs->pos == ' ') || (*curs->pos == '\t') 
+		|| (*curs->pos == '\r') || (*curs->pos == '\n')))
+	{
+		curs->pos++;
+	}
+}
+
+/* Matches the literal exactly, without skipping anything beforehand */
+static AOC_STAT scanExpect(struct aocCursor *curs, const char *literal)
+{
+	const char *pos = curs->pos;
+
+	while (*literal != '\0')
+	{
+		if ((pos >= curs->end) || (*pos != *literal))
+		{
+			return AOC_FAILURE;
+		}
+
+		pos++;
+		literal++;
+	}
+
+	curs->pos = pos;
+
+	return AOC_SUCCESS;
+}
+
+/* Reads a run of decimal digits, failing if there are none or if the value
+ * would overflow an unsigned long */
+static AOC_STAT scanDigits(struct aocCursor *curs, unsigned long int *out)
+{
+	const char *pos = curs->pos;
+	unsigned long int val = 0;
+
+	if ((pos >= curs->end) || (!AOC_IS_DIGIT(*pos)))
+	{
+		return AOC_FAILURE;
+	}
+
+	do
+	{
+		const unsigned int digit = *pos - '0';
+
+		if (val > (ULONG_MAX - digit) / 10)
+		{
+			return AOC_FAILURE;
+		}
+
+		val = (val * 10) + digit;
+		pos++;
+	} while ((pos < curs->end) && (AOC_IS_DIGIT(*pos)));
+
+	curs->pos = pos;
+	*out = val;
+
+	return AOC_SUCCESS;
+}
+
+/* Optionally signed decimal value, failing if it doesn't fit in a long */
+static AOC_STAT scanLong(struct aocCursor *curs, long int *out)
+{
+	struct aocCursor tmp = *curs;
+	unsigned long int mag;
+	AOC_BOOL negative = AOC_FALSE;
+
+	if ((tmp.pos < tmp.end) && ((*tmp.pos == '-') || (*tmp.pos == '+')))
+	{
+		negative = (*tmp.pos == '-');
+		tmp.pos++;
+	}
+
+	if (scanDigits(&tmp, &mag) != AOC_SUCCESS)
+	{
+		return AOC_FAILURE;
+	}
+
+	if (negative == AOC_TRUE)
+	{
+		if (mag > (unsigned long int) LONG_MAX + 1)
+		{
+			return AOC_FAILURE;
+		}
+
+		*out = (mag == (unsigned long int) LONG_MAX + 1)
+			? LONG_MIN
+			: -((long int) mag);
+	}
+	else
+	{
+		if (mag > (unsigned long int) LONG_MAX)
+		{
+			return AOC_FAILURE;
+		}
+
+		*out = (long int) mag;
+	}
+
+	*curs = tmp;
+
+	return AOC_SUCCESS;
+}
+
+/* Skips ahead to the next digit, or minus sign directly followed by one, and
+ * reads the value that starts there */
+static AOC_STAT scanNextLong(struct aocCursor *curs, long int *out)
+{
+	struct aocCursor tmp = *curs;
+
+	while ((tmp.pos < tmp.end) && (!AOC_IS_DIGIT(*tmp.pos))
+	&& ((*tmp.pos != '-') || (tmp.pos + 1 >= tmp.end) 
+		|| (!AOC_IS_DIGIT(tmp.pos[1]))))
+	{
+		tmp.pos++;
+	}
+
+	if (scanLong(&tmp, out) != AOC_SUCCESS)
+	{
+		return AOC_FAILURE;
+	}
+
+	*curs = tmp;
+
+	return AOC_SUCCESS;
+}
+
+/* Whitespace, then the label exactly, then a value, eg: "Prize: X=" 8400 */
+static AOC_STAT scanLabeledLong(struct aocCursor *curs, const char *label,
+	long int *out)
+{
+	struct aocCursor tmp = *curs;
+
+	scanSkipSpace(&tmp);
+
+	if ((scanExpect(&tmp, label) != AOC_SUCCESS)
+	|| (scanLong(&tmp, out) != AOC_SUCCESS))
+	{
+		return AOC_FAILURE;
+	}
+
+	*curs = tmp;
+
+	return AOC_SUCCESS;
+}
+
+/* Flat row-major character grid. The cells can be surrounded by 'pad' rows
+ * and columns of a sentinel value so that looking up to 'pad' cells away from
+ * any in-bounds cell never needs a bounds check, the sentinel just has to be
+ * a value the caller never searches for */
+struct aocGrid
+{
+	char *cells;   /* Cell (0, 0), padding lives at negative offsets */
+	size_t rows;
+	size_t cols;
+	size_t stride; /* Distance between vertically adjacent cells */
+	size_t pad;
+	struct aocArena *arena;
+};
+
+/* Coordinates are treated as signed so padding cells can be addressed */
+#define AOC_GRID_OFFSET(grid, x, y) \
+	((long int) (y) * (long int) (grid)->stride + (long int) (x))
+
+#define AOC_GRID_AT(grid, x, y) \
+	((grid)->cells[AOC_GRID_OFFSET((grid), (x), (y))])
+
+#define AOC_GRID_IN_BOUNDS(grid, x, y)                     \
+	(((x) >= 0) && ((y) >= 0)                          \
+		&& ((unsigned long int) (x) < (grid)->cols) \
+		&& ((unsigned long int) (y) < (grid)->rows))
+
+static void gridFree(struct aocGrid *grid)
+{
+	if (grid != NULL)
+	{
+		arenaDestroy(grid->arena);
+		grid->arena = NULL;
+		grid->cells = NULL;
+	}
+}
+
+/* Copies newline separated rows of equal length out of the view until the 
+ * end of the input or the first blank line. The view length gives an upper
+ * bound on the number of rows so the whole grid, padding included, is a 
+ * single allocation. An empty input, or one that opens with a blank line,
+ * loads as a grid of no rows or columns */
+static AOC_STAT gridLoad(const struct aocView *input, struct aocGrid *grid, 
+	const size_t pad, const char sentinel)
+{
+	const char *line = NULL;
+	size_t line_len, max_rows, total;
+	size_t cursor = 0;
+	char *base = NULL;
+
+	if ((input == NULL) || (grid == NULL))
+	{
+		return AOC_FAILURE;
+	}
+
+	if (viewNextLine(input, &cursor, &line, &grid->cols) == AOC_FALSE)
+	{
+		grid->cols = 0;
+	}
+
+	/* Every row except possibly the last is followed by a newline */
+	max_rows = (grid->cols == 0) ? 0 : (input->len / (grid->cols + 1)) + 1;
+	grid->rows = 0;
+	grid->pad = pad;
+	grid->stride = grid->cols + (pad * 2);
+	total = grid->stride * (max_rows + (pad * 2));
+
+	if (((grid->arena = arenaCreate(total)) == NULL)
+	|| ((base = arenaAlloc(grid->arena, total, 1)) == NULL))
+	{
+		gridFree(grid);
+
+		return AOC_FAILURE;
+	}
+
+	memset(base, sentinel, total);
+	grid->cells = base + (grid->stride * pad) + pad;
+	cursor = 0;
+
+	while ((viewNextLine(input, &cursor, &line, &line_len) == AOC_TRUE)
+	&& (line_len != 0))
+	{
+		/* Ragged rows aren't a grid */
+		if (line_len != grid->cols)
+		{
+			gridFree(grid);
+
+			return AOC_FAILURE;
+		}
+
+		AOC_ASSERT(grid->rows < max_rows);
+		memcpy(&AOC_GRID_AT(grid, 0, grid->rows), line, line_len);
+		grid->rows++;
+	}
+
+	return AOC_SUCCESS;
+}
+
+/* A fixed set of worker threads taking tasks off of a shared FIFO queue.
+ * Tasks are only ever appended while the queue is busy, once it drains and
+ * nothing is running the queue is rewound so it never grows beyond the most
+ * tasks that were outstanding at once */
+struct aocPoolTask
+{
+	void (*Run)(void *arg);
+	void *arg;
+};
+
+struct aocPool
+{
+	struct aocPoolTask *tasks;
+	size_t head;   /* Next task to be handed out */
+	size_t len;
+	size_t max;
+	size_t active; /* Handed out but not yet finished */
+	AOC_BOOL stopping;
+#if defined(AOC_USE_THREADS)
+	pthread_t *threads;
+	size_t num_threads;
+	pthread_mutex_t lock;
+	pthread_cond_t has_work;
+	pthread_cond_t is_idle;
+#endif /* AOC_USE_THREADS */
+};
+
+#if defined(AOC_USE_THREADS)
+static void* poolWorker(void *arg)
+{
+	struct aocPool *pool = arg;
+	struct aocPoolTask task;
+
+	pthread_mutex_lock(&pool->lock);
+
+	for (;;)
+	{
+		while ((pool->head == pool->len) 
+		&& (pool->stopping == AOC_FALSE))
+		{
+			pthread_cond_wait(&pool->has_work, &pool->lock);
+		}
+
+		/* Only stop once everything queued has been run */
+		if (pool->head == pool->len)
+		{
+			break;
+		}
+
+		task = pool->tasks[pool->head++];
+		pool->active++;
+		pthread_mutex_unlock(&pool->lock);
+
+		task.Run(task.arg);
+
+		pthread_mutex_lock(&pool->lock);
+		pool->active--;
+
+		if ((pool->head == pool->len) && (pool->active == 0))
+		{
+			pool->head = 0;
+			pool->len = 0;
+			pthread_cond_broadcast(&pool->is_idle);
+		}
+	}
+
+	pthread_mutex_unlock(&pool->lock);
+
+	return NULL;
+}
+#endif /* AOC_USE_THREADS */
+
+/* Number of processors online, or 1 when that can't be known */
+static size_t poolDefaultThreads(void)
+{
+#if defined(AOC_USE_THREADS) && defined(_SC_NPROCESSORS_ONLN)
+	const long int online = sysconf(_SC_NPROCESSORS_ONLN);
+
+	if (online > 0)
+	{
+		return online;
+	}
+#endif /* AOC_USE_THREADS && _SC_NPROCESSORS_ONLN */
+
+	return 1;
+}
+
+static void poolDestroy(struct aocPool *pool);
+
+static struct aocPool* poolCreate(size_t num_threads)
+{
+	struct aocPool *pool = NULL;
+
+	if ((pool = malloc(sizeof(struct aocPool))) == NULL)
+	{
+		return NULL;
+	}
+
+	pool->head = 0;
+	pool->len = 0;
+	pool->max = 16;
+	pool->active = 0;
+	pool->stopping = AOC_FALSE;
+	AOC_NEW_DYN_ARR(struct aocPoolTask, pool->tasks, pool->max);
+
+#if defined(AOC_USE_THREADS)
+	if (num_threads == 0)
+	{
+		num_threads = 1;
+	}
+
+	pool->num_threads = 0;
+	pool->threads = malloc(sizeof(pthread_t) * num_threads);
+
+	if ((pool->threads == NULL)
+	|| (pthread_mutex_init(&pool->lock, NULL) != 0))
+	{
+		AOC_FREE(pool->threads);
+		AOC_FREE(pool->tasks);
+		AOC_FREE(pool);
+
+		return NULL;
+	}
+
+	pthread_cond_init(&pool->has_work, NULL);
+	pthread_cond_init(&pool->is_idle, NULL);
+
+	for (; pool->num_threads < num_threads; pool->num_threads++)
+	{
+		if (pthread_create(&pool->threads[pool->num_threads], NULL,
+			poolWorker, pool) != 0)
+		{
+			break;
+		}
+	}
+
+	/* Running short of the requested threads is fine, having none isn't */
+	if (pool->num_threads == 0)
+	{
+		poolDestroy(pool);
+
+		return NULL;
+	}
+#else
+	(void) num_threads;
+#endif /* AOC_USE_THREADS */
+
+	return pool;
+}
+
+static void poolSubmit(struct aocPool *pool, void (*Run)(void *),
+	void *arg)
+{
+	struct aocPoolTask task;
+
+	task.Run = Run;
+	task.arg = arg;
+
+#if defined(AOC_USE_THREADS)
+	pthread_mutex_lock(&pool->lock);
+	AOC_CAT_DYN_ARR(struct aocPoolTask, pool->tasks, pool->len, pool->max,
+		task);
+	pthread_cond_signal(&pool->has_work);
+	pthread_mutex_unlock(&pool->lock);
+#else
+	(void) pool;
+	task.Run(task.arg);
+#endif /* AOC_USE_THREADS */
+}
+
+/* Blocks until every task submitted so far has finished */
+static void poolWait(struct aocPool *pool)
+{
+#if defined(AOC_USE_THREADS)
+	pthread_mutex_lock(&pool->lock);
+
+	while ((pool->head != pool->len) || (pool->active != 0))
+	{
+		pthread_cond_wait(&pool->is_idle, &pool->lock);
+	}
+
+	pthread_mutex_unlock(&pool->lock);
+#else
+	(void) pool;
+#endif /* AOC_USE_THREADS */
+}
+
+/* Any tasks still queued are run before the workers exit */
+static void poolDestroy(struct aocPool *pool)
+{
+	if (pool == NULL)
+	{
+		return;
+	}
+
+#if defined(AOC_USE_THREADS)
+	{
+		size_t i;
+
+		pthread_mutex_lock(&pool->lock);
+		pool->stopping = AOC_TRUE;
+		pthread_cond_broadcast(&pool->has_work);
+		pthread_mutex_unlock(&pool->lock);
+
+		for (i = 0; i < pool->num_threads; i++)
+		{
+			pthread_join(pool->threads[i], NULL);
+		}
+
+		pthread_cond_destroy(&pool->is_idle);
+		pthread_cond_destroy(&pool->has_work);
+		pthread_mutex_destroy(&pool->lock);
+		AOC_FREE(pool->threads);
+	}
+#endif /* AOC_USE_THREADS */
+
+	AOC_FREE(pool->tasks);
+	AOC_FREE(pool);
+}
+
+/* Number of workers a parallel for is split across, and so how many
+ * reduction slots its caller needs */
+static size_t poolNumSlots(const struct aocPool *pool)
+{
+#if defined(AOC_USE_THREADS)
+	return pool->num_threads;
+#else
+	(void) pool;
+
+	return 1;
+#endif /* AOC_USE_THREADS */
+}
+
+/* Per slot accumulators padded out to a cache line so that slots updated by
+ * different workers never share one */
+#define AOC_CACHE_LINE_LEN (64)
+
+union aocPoolSum
+{
+	AOC_ACC sum;
+	unsigned char pad[AOC_CACHE_LINE_LEN];
+};
+
+/* The part of the index range still owed by one slot. Its owner takes grains
+ * off of the front while thieves take half of what's left off of the back */
+struct aocPoolRange
+{
+	size_t begin;
+	size_t end;
+#if defined(AOC_USE_THREADS)
+	pthread_mutex_t lock;
+#endif /* AOC_USE_THREADS */
+};
+
+struct aocParallelFor
+{
+	struct aocPoolRange *ranges;
+	size_t num_slots;
+	size_t grain;
+	void (*Body)(void *ctx, size_t begin, size_t end, size_t slot);
+	void *ctx;
+};
+
+struct aocParallelTask
+{
+	struct aocParallelFor *job;
+	size_t slot;
+};
+
+/* How a parallel for runs without a second worker to share it with */
+static void parallelSerial(const size_t begin, const size_t end, 
+	const size_t grain, 
+	void (*Body)(void *ctx, size_t begin, size_t end, size_t slot),
+	void *ctx)
+{
+	size_t i;
+
+	for (i = begin; i < end; i += grain)
+	{
+		Body(ctx, i, i + AOC_MIN(grain, end - i), 0);
+	}
+}
+
+#if defined(AOC_USE_THREADS)
+/* Moves half of the first unfinished range found after the thief's own into
+ * it, all of the range when it's down to a grain or less */
+static AOC_BOOL parallelSteal(struct aocParallelFor *job, const size_t slot)
+{
+	size_t i;
+
+	for (i = 1; i < job->num_slots; i++)
+	{
+		struct aocPoolRange *victim 
+			= &job->ranges[(slot + i) % job->num_slots];
+		struct aocPoolRange *own = &job->ranges[slot];
+		size_t begin, end;
+
+		pthread_mutex_lock(&victim->lock);
+		end = victim->end;
+		begin = ((end - victim->begin) > job->grain) 
+			? end - ((end - victim->begin) / 2)
+			: victim->begin;
+		victim->end = begin;
+		pthread_mutex_unlock(&victim->lock);
+
+		if (begin < end)
+		{
+			pthread_mutex_lock(&own->lock);
+			own->begin = begin;
+			own->end = end;
+			pthread_mutex_unlock(&own->lock);
+
+			return AOC_TRUE;
+		}
+	}
+
+	return AOC_FALSE;
+}
+
+static void parallelWorker(void *arg)
+{
+	const struct aocParallelTask *task = arg;
+	struct aocParallelFor *job = task->job;
+	struct aocPoolRange *own = &job->ranges[task->slot];
+
+	for (;;)
+	{
+		size_t begin, end;
+
+		pthread_mutex_lock(&own->lock);
+		begin = own->begin;
+		end = AOC_MIN(begin + job->grain, own->end);
+		own->begin = end;
+		pthread_mutex_unlock(&own->lock);
+
+		if (begin < end)
+		{
+			job->Body(job->ctx, begin, end, task->slot);
+		}
+		else if (parallelSteal(job, task->slot) == AOC_FALSE)
+		{
+			break;
+		}
+	}
+}
+#endif /* AOC_USE_THREADS */
+
+/* Calls Body over [begin, end) in pieces of at most 'grain' indices, or an
+ * eighth of each worker's share when grain is 0. Each worker starts on an
+ * even share of the range and steals from the others once it runs out, so
+ * uneven iterations still balance. Body is told which of the poolNumSlots
+ * slots it's running for so that results can be reduced per slot without
+ * locking, see union aocPoolSum. Returns once every index is done. The pool
+ * is waited on so it must not have other tasks outstanding, and this can't
+ * be called from one of its own tasks */
+static AOC_STAT poolParallelFor(struct aocPool *pool, const size_t begin,
+	const size_t end, const size_t grain, 
+	void (*Body)(void *ctx, size_t begin, size_t end, size_t slot),
+	void *ctx)
+{
+#if defined(AOC_USE_THREADS)
+	struct aocParallelFor job;
+	struct aocParallelTask *tasks = NULL;
+	const size_t len = (end > begin) ? end - begin : 0;
+	size_t i;
+
+	job.num_slots = poolNumSlots(pool);
+	job.grain = (grain != 0) 
+		? grain 
+		: AOC_MAX(len / (job.num_slots * 8), 1);
+	job.Body = Body;
+	job.ctx = ctx;
+
+	if ((len == 0) || (job.num_slots == 1))
+	{
+		parallelSerial(begin, end, job.grain, Body, ctx);
+
+		return AOC_SUCCESS;
+	}
+
+	if (((job.ranges = malloc(sizeof(struct aocPoolRange) 
+		* job.num_slots)) == NULL)
+	|| ((tasks = malloc(sizeof(struct aocParallelTask) 
+		* job.num_slots)) == NULL))
+	{
+		AOC_FREE(job.ranges);
+
+		return AOC_FAILURE;
+	}
+
+	for (i = 0; i < job.num_slots; i++)
+	{
+		job.ranges[i].begin = begin + (len * i) / job.num_slots;
+		job.ranges[i].end = begin + (len * (i + 1)) / job.num_slots;
+		pthread_mutex_init(&job.ranges[i].lock, NULL);
+		tasks[i].job = &job;
+		tasks[i].slot = i;
+	}
+
+	for (i = 0; i < job.num_slots; i++)
+	{
+		poolSubmit(pool, parallelWorker, &tasks[i]);
+	}
+
+	poolWait(pool);
+
+	for (i = 0; i < job.num_slots; i++)
+	{
+		pthread_mutex_destroy(&job.ranges[i].lock);
+	}
+
+	AOC_FREE(job.ranges);
+	AOC_FREE(tasks);
+#else
+	const size_t len = (end > begin) ? end - begin : 0;
+
+	(void) pool;
+	parallelSerial(begin, end, (grain != 0) ? grain : AOC_MAX(len / 8, 1), 
+		Body, ctx);
+#endif /* AOC_USE_THREADS */
+
+	return AOC_SUCCESS;
+}
+
+/* Every day exposes its phases through one of these so that a driver can
+ * run, and time, each of them on their own. Parse builds the day's working
+ * state out of the view and hands it back as an opaque context, or NULL on
+ * failure, which the parts then solve from. The formats are given the answer
+ * as a string from accFormat, a day with only one part solved leaves Part2
+ * as NULL */
+struct aocDay
+{
+	int number;
+	void* (*Parse)(const struct aocView *input);
+	AOC_STAT (*Part1)(void *ctx, AOC_ACC *answer);
+	AOC_STAT (*Part2)(void *ctx, AOC_ACC *answer);
+	void (*Free)(void *ctx);
+	const char *part_1_fmt;
+	const char *part_2_fmt;
+};
+
+/* Timestamps in seconds for measuring intervals. The monotonic clock needs
+ * POSIX, build with -DAOC_USE_MONOTONIC -D_POSIX_C_SOURCE=200112L to enable
+ * it, otherwise this falls back on processor time from clock() */
+static double clockSeconds(void)
+{
+#if defined(AOC_USE_MONOTONIC)
+	struct timespec now;
+
+	if (clock_gettime(CLOCK_MONOTONIC, &now) == 0)
+	{
+		return (double) now.tv_sec + ((double) now.tv_nsec / 1e9);
+	}
+#endif /* AOC_USE_MONOTONIC */
+
+	return (double) clock() / CLOCKS_PER_SEC;
+}
+
+/* Tracing spans and counters, written as Chrome trace event JSON that
+ * chrome://tracing or Perfetto can open. Build with -DAOC_TRACE to record
+ * them, otherwise the macros expand to nothing. -DAOC_USE_MONOTONIC should
+ * also be given as the timestamps come from clockSeconds. Names are kept by
+ * pointer so they must be string literals, and every AOC_TRACE_BEGIN needs
+ * an AOC_TRACE_END with the same name on the same thread.
+ *
+ * Events are buffered and written at exit to the file named by the
+ * AOC_TRACE_FILE environment variable, or aoc_trace.json. Programs linking
+ * several days have a buffer per translation unit, so each appends its
+ * events to the one file using the JSON array format, which doesn't need
+ * the closing bracket */
+#if defined(AOC_TRACE)
+
+#define AOC_TRACE_BEGIN(name) traceEvent((name), 'B', 0)
+#define AOC_TRACE_END(name) traceEvent((name), 'E', 0)
+#define AOC_TRACE_COUNTER(name, val) traceEvent((name), 'C', (long int) (val))
+
+struct aocTraceEvent
+{
+	const char *name;
+	double time;
+	long int value;
+	unsigned long int thread;
+	char phase;
+};
+
+static struct
+{
+	struct aocTraceEvent *events;
+	size_t len;
+	size_t max;
+	AOC_BOOL is_registered;
+#if defined(AOC_USE_THREADS)
+	pthread_mutex_t lock;
+#endif /* AOC_USE_THREADS */
+} aoc_trace =
+{
+	NULL, 0, 0, AOC_FALSE
+#if defined(AOC_USE_THREADS)
+	, PTHREAD_MUTEX_INITIALIZER
+#endif /* AOC_USE_THREADS */
+};
+
+#if defined(AOC_USE_THREADS)
+#define AOC_TRACE_LOCK() pthread_mutex_lock(&aoc_trace.lock)
+#define AOC_TRACE_UNLOCK() pthread_mutex_unlock(&aoc_trace.lock)
+#else
+#define AOC_TRACE_LOCK() ((void) 0)
+#define AOC_TRACE_UNLOCK() ((void) 0)
+#endif /* AOC_USE_THREADS */
+
+static const char* traceFilePath(void)
+{
+	const char *path = getenv("AOC_TRACE_FILE");
+
+	return ((path == NULL) || (*path == '\0')) ? "aoc_trace.json" : path;
+}
+
+/* pthread_t is opaque so the id is hashed out of its bytes, which keeps it
+ * the same across translation units */
+static unsigned long int traceThreadId(void)
+{
+#if defined(AOC_USE_THREADS)
+	const pthread_t self = pthread_self();
+	const unsigned char *bytes = (const unsigned char *) &self;
+	unsigned long int hash = 2166136261ul;
+	size_t i;
+
+	for (i = 0; i < sizeof(pthread_t); i++)
+	{
+		hash = ((hash ^ bytes[i]) * 16777619ul) & 0xFFFFFFFFul;
+	}
+
+	return hash;
+#else
+	return 1;
+#endif /* AOC_USE_THREADS */
+}
+
+static void traceWrite(void)
+{
+	FILE *out = NULL;
+	AOC_BOOL is_first;
+	size_t i;
+
+	AOC_TRACE_LOCK();
+
+	if ((out = fopen(traceFilePath(), "a")) == NULL)
+	{
+		fprintf(stderr, "Unable to write trace '%s'\n", 
+			traceFilePath());
+		AOC_TRACE_UNLOCK();
+
+		return;
+	}
+
+	fseek(out, 0, SEEK_END);
+
+	if ((is_first = (ftell(out) == 0)) == AOC_TRUE)
+	{
+		fputc('[', out);
+	}
+
+	for (i = 0; i < aoc_trace.len; i++)
+	{
+		const struct aocTraceEvent *event = &aoc_trace.events[i];
+
+		fprintf(out, "%s\n{\"name\": \"%s\", \"ph\": \"%c\", "
+			"\"ts\": %.3f, \"pid\": 1, \"tid\": %lu", 
+			((is_first == AOC_TRUE) && (i == 0)) ? "" : ",",
+			event->name, event->phase, event->time * 1e6,
+			event->thread);
+
+		if (event->phase == 'C')
+		{
+			fprintf(out, ", \"args\": {\"value\": %ld}", 
+				event->value);
+		}
+
+		fputc('}', out);
+	}
+
+	fclose(out);
+	free(aoc_trace.events);
+	aoc_trace.events = NULL;
+	aoc_trace.len = 0;
+	aoc_trace.max = 0;
+	AOC_TRACE_UNLOCK();
+}
+
+/* The first event truncates any trace left by an earlier run. Nothing is
+ * written until exit so this can't clobber another translation unit's
+ * events from this run */
+static void traceEvent(const char *name, const char phase, 
+	const long int value)
+{
+	struct aocTraceEvent *event = NULL;
+	const double now = clockSeconds();
+
+	AOC_TRACE_LOCK();
+
+	if (aoc_trace.is_registered == AOC_FALSE)
+	{
+		FILE *out = fopen(traceFilePath(), "w");
+
+		if (out != NULL)
+		{
+			fclose(out);
+		}
+
+		atexit(traceWrite);
+		aoc_trace.is_registered = AOC_TRUE;
+	}
+
+	if (aoc_trace.len == aoc_trace.max)
+	{
+		const size_t max = (aoc_trace.max == 0) 
+			? 1024 
+			: aoc_trace.max * 2;
+		struct aocTraceEvent *events = realloc(aoc_trace.events,
+			sizeof(struct aocTraceEvent) * max);
+
+		/* Drops the event rather than failing the run */
+		if (events == NULL)
+		{
+			AOC_TRACE_UNLOCK();
+
+			return;
+		}
+
+		aoc_trace.events = events;
+		aoc_trace.max = max;
+	}
+
+	event = &aoc_trace.events[aoc_trace.len++];
+	event->name = name;
+	event->time = now;
+	event->value = value;
+	event->thread = traceThreadId();
+	event->phase = phase;
+	AOC_TRACE_UNLOCK();
+}
+
+#else
+#define AOC_TRACE_BEGIN(name) ((void) 0)
+#define AOC_TRACE_END(name) ((void) 0)
+#define AOC_TRACE_COUNTER(name, val) ((void) 0)
+#endif /* AOC_TRACE */
+
+/* 32 bit xxHash of a block of bytes. The words are read a byte at a time so
+ * the hash doesn't depend on the host's byte order or alignment */
+#define AOC_XXH_PRIME_1 (2654435761ul)
+#define AOC_XXH_PRIME_2 (2246822519ul)
+#define AOC_XXH_PRIME_3 (3266489917ul)
+#define AOC_XXH_PRIME_4 (668265263ul)
+#define AOC_XXH_PRIME_5 (374761393ul)
+#define AOC_XXH_MASK (0xFFFFFFFFul)
+#define AOC_XXH_ROTL(val, bits) \
+	((((val) << (bits)) | ((val) >> (32 - (bits)))) & AOC_XXH_MASK)
+
+static unsigned long int xxHashRead(const unsigned char *bytes)
+{
+	return (unsigned long int) bytes[0]
+		| ((unsigned long int) bytes[1] << 8)
+		| ((unsigned long int) bytes[2] << 16)
+		| ((unsigned long int) bytes[3] << 24);
+}
+
+static unsigned long int xxHashRound(unsigned long int acc, 
+	const unsigned long int word)
+{
+	acc = (acc + word * AOC_XXH_PRIME_2) & AOC_XXH_MASK;
+	acc = AOC_XXH_ROTL(acc, 13);
+
+	return (acc * AOC_XXH_PRIME_1) & AOC_XXH_MASK;
+}
+
+static unsigned long int xxHash32(const void *data, const size_t len,
+	const unsigned long int seed)
+{
+	const unsigned char *curr = data;
+	const unsigned char * const end = curr + len;
+	unsigned long int hash;
+
+	if (len >= 16)
+	{
+		const unsigned char * const limit = end - 16;
+		unsigned long int acc[4];
+
+		acc[0] = (seed + AOC_XXH_PRIME_1 + AOC_XXH_PRIME_2) 
+			& AOC_XXH_MASK;
+		acc[1] = (seed + AOC_XXH_PRIME_2) & AOC_XXH_MASK;
+		acc[2] = seed & AOC_XXH_MASK;
+		acc[3] = (seed - AOC_XXH_PRIME_1) & AOC_XXH_MASK;
+
+		do
+		{
+			acc[0] = xxHashRound(acc[0], xxHashRead(curr));
+			acc[1] = xxHashRound(acc[1], xxHashRead(curr + 4));
+			acc[2] = xxHashRound(acc[2], xxHashRead(curr + 8));
+			acc[3] = xxHashRound(acc[3], xxHashRead(curr + 12));
+			curr += 16;
+		} while (curr <= limit);
+
+		hash = (AOC_XXH_ROTL(acc[0], 1) + AOC_XXH_ROTL(acc[1], 7)
+			+ AOC_XXH_ROTL(acc[2], 12) + AOC_XXH_ROTL(acc[3], 18))
+			& AOC_XXH_MASK;
+	}
+	else
+	{
+		hash = (seed + AOC_XXH_PRIME_5) & AOC_XXH_MASK;
+	}
+
+	hash = (hash + (unsigned long int) len) & AOC_XXH_MASK;
+
+	for (; curr + 4 <= end; curr += 4)
+	{
+		hash = (hash + xxHashRead(curr) * AOC_XXH_PRIME_3) 
+			& AOC_XXH_MASK;
+		hash = (AOC_XXH_ROTL(hash, 17) * AOC_XXH_PRIME_4) 
+			& AOC_XXH_MASK;
+	}
+
+	for (; curr < end; curr++)
+	{
+		hash = (hash + *curr * AOC_XXH_PRIME_5) & AOC_XXH_MASK;
+		hash = (AOC_XXH_ROTL(hash, 11) * AOC_XXH_PRIME_1) 
+			& AOC_XXH_MASK;
+	}
+
+	hash ^= hash >> 15;
+	hash = (hash * AOC_XXH_PRIME_2) & AOC_XXH_MASK;
+	hash ^= hash >> 13;
+	hash = (hash * AOC_XXH_PRIME_3) & AOC_XXH_MASK;
+	hash ^= hash >> 16;
+
+	return hash;
+}
+
+/* Answers of earlier runs, cached on disk so a repeated input skips parsing
+ * and solving. Build with -DAOC_CACHE to enable it, otherwise every lookup
+ * misses without touching the disk. Entries are files in the directory named
+ * by the AOC_CACHE_DIR environment variable, or the current one, and hits and
+ * misses are reported on stderr at exit.
+ *
+ * An entry is keyed on two xxHashes of the input, each seeded from the day
+ * and the code version. AOC_CODE_VERSION defaults to the build time so that
+ * rebuilding drops every entry, give it something like the commit instead,
+ * eg: -DAOC_CODE_VERSION=\"$(git rev-parse HEAD)\", to keep entries across
+ * builds of the same code */
+#ifndef AOC_CODE_VERSION
+#define AOC_CODE_VERSION (__DATE__ " " __TIME__)
+#endif /* AOC_CODE_VERSION */
+
+struct aocCacheEntry
+{
+	unsigned long int key[2];
+	unsigned long int len;
+	AOC_ACC answers[2];
+};
+
+#if defined(AOC_CACHE)
+
+static struct
+{
+	unsigned long int hits;
+	unsigned long int misses;
+	unsigned long int stores; /* Numbers each store's temporary file */
+	AOC_BOOL is_registered;
+#if defined(AOC_USE_THREADS)
+	pthread_mutex_t lock;
+#endif /* AOC_USE_THREADS */
+} aoc_cache =
+{
+	0, 0, 0, AOC_FALSE
+#if defined(AOC_USE_THREADS)
+	, PTHREAD_MUTEX_INITIALIZER
+#endif /* AOC_USE_THREADS */
+};
+
+#if defined(AOC_USE_THREADS)
+#define AOC_CACHE_LOCK() pthread_mutex_lock(&aoc_cache.lock)
+#define AOC_CACHE_UNLOCK() pthread_mutex_unlock(&aoc_cache.lock)
+#else
+#define AOC_CACHE_LOCK() ((void) 0)
+#define AOC_CACHE_UNLOCK() ((void) 0)
+#endif /* AOC_USE_THREADS */
+
+/* Separate runs sharing a cache directory are told apart by their process
+ * id where POSIX gives one */
+#if defined(AOC_USE_THREADS) || defined(AOC_USE_MMAP)
+#define AOC_CACHE_PID() ((unsigned long int) getpid())
+#else
+#define AOC_CACHE_PID() (0ul)
+#endif /* AOC_USE_THREADS || AOC_USE_MMAP */
+
+static void cacheReport(void)
+{
+	/* Keeps the report after any answers still sitting in the buffer */
+	fflush(stdout);
+
+	AOC_CACHE_LOCK();
+	fprintf(stderr, "Cache: %lu hits, %lu misses\n", aoc_cache.hits,
+		aoc_cache.misses);
+	AOC_CACHE_UNLOCK();
+}
+
+static void cacheCount(const AOC_BOOL is_hit)
+{
+	AOC_CACHE_LOCK();
+
+	if (aoc_cache.is_registered == AOC_FALSE)
+	{
+		atexit(cacheReport);
+		aoc_cache.is_registered = AOC_TRUE;
+	}
+
+	if (is_hit == AOC_TRUE)
+	{
+		aoc_cache.hits++;
+	}
+	else
+	{
+		aoc_cache.misses++;
+	}
+
+	AOC_CACHE_UNLOCK();
+}
+
+/* The returned path is the caller's to free, or NULL if it couldn't be made */
+static char* cachePath(const struct aocDay *day, 
+	const struct aocCacheEntry *entry)
+{
+	const char *dir = getenv("AOC_CACHE_DIR");
+	char *path = NULL;
+
+	if ((dir == NULL) || (*dir == '\0'))
+	{
+		dir = ".";
+	}
+
+	/* Room for the separator and the name */
+	if ((path = malloc(strlen(dir) + 48)) != NULL)
+	{
+		sprintf(path, "%s/aoc_cache_%02d_%08lx%08lx.txt", dir, 
+			day->number, entry->key[0], entry->key[1]);
+	}
+
+	return path;
+}
+
+/* Keys the entry on the input and fills in its answers if an earlier run
+ * cached them. Entries that don't match the day or the input's length are
+ * treated as misses and are replaced by the next store */
+static AOC_BOOL cacheLoad(const struct aocDay *day, 
+	const struct aocView *input, struct aocCacheEntry *entry)
+{
+	const char *version = AOC_CODE_VERSION;
+	const unsigned long int seed = xxHash32(version, strlen(version),
+		(unsigned long int) day->number);
+	AOC_BOOL is_hit = AOC_FALSE;
+	FILE *cached = NULL;
+	char *path = NULL;
+	unsigned long int key[2], len;
+	char answers[2][AOC_ACC_DIGITS];
+	int number;
+
+	AOC_TRACE_BEGIN("cache");
+	entry->key[0] = xxHash32(input->data, input->len, seed);
+	entry->key[1] = xxHash32(input->data, input->len, 
+		seed ^ AOC_XXH_PRIME_1);
+	entry->len = input->len;
+	entry->answers[0] = 0;
+	entry->answers[1] = 0;
+
+	if (((path = cachePath(day, entry)) != NULL)
+	&& ((cached = fopen(path, "r")) != NULL))
+	{
+		is_hit = (fscanf(cached, "%d %lu %lx %lx %40s %40s", &number,
+			&len, &key[0], &key[1], answers[0], answers[1]) == 6)
+			&& (number == day->number) && (len == entry->len)
+			&& (key[0] == entry->key[0]) 
+			&& (key[1] == entry->key[1])
+			&& (accParse(answers[0], &entry->answers[0]) 
+				== AOC_SUCCESS)
+			&& (accParse(answers[1], &entry->answers[1]) 
+				== AOC_SUCCESS);
+		fclose(cached);
+	}
+
+	free(path);
+	cacheCount(is_hit);
+	AOC_TRACE_END("cache");
+
+	return is_hit;
+}
+
+/* Written to a temporary file first and renamed over the entry so that a
+ * concurrent run never reads half of one. Every store has a temporary file
+ * of its own, named for the process and the store, as jobs solving the same
+ * input at once would otherwise write to and rename the same one */
+static void cacheStore(const struct aocDay *day, 
+	const struct aocCacheEntry *entry)
+{
+	FILE *cached = NULL;
+	char *path = NULL;
+	char *tmp_path = NULL;
+	char answers[2][AOC_ACC_DIGITS];
+	unsigned long int store;
+	AOC_BOOL is_written;
+
+	/* Two decimal longs along with the dots and the ".tmp" suffix */
+	if (((path = cachePath(day, entry)) == NULL)
+	|| ((tmp_path = malloc(strlen(path) + (2 * AOC_ACC_DIGITS) + 8)) 
+		== NULL))
+	{
+		free(path);
+
+		return;
+	}
+
+	AOC_CACHE_LOCK();
+	store = aoc_cache.stores++;
+	AOC_CACHE_UNLOCK();
+	sprintf(tmp_path, "%s.%lu.%lu.tmp", path, AOC_CACHE_PID(), store);
+
+	if ((cached = fopen(tmp_path, "w")) != NULL)
+	{
+		is_written = fprintf(cached, "%d %lu %08lx %08lx %s %s\n", 
+			day->number, entry->len, entry->key[0], entry->key[1], 
+			accFormat(entry->answers[0], answers[0]), 
+			accFormat(entry->answers[1], answers[1])) > 0;
+		is_written = (fclose(cached) == 0) && is_written;
+
+		if ((is_written == AOC_FALSE) || (rename(tmp_path, path) != 0))
+		{
+			fprintf(stderr, "Unable to cache answers in '%s'\n", 
+				path);
+			remove(tmp_path);
+		}
+	}
+
+	free(path);
+	free(tmp_path);
+}
+
+#else
+
+static AOC_BOOL cacheLoad(const struct aocDay *day, 
+	const struct aocView *input, struct aocCacheEntry *entry)
+{
+	(void) day;
+	(void) input;
+	(void) entry;
+
+	return AOC_FALSE;
+}
+
+static void cacheStore(const struct aocDay *day, 
+	const struct aocCacheEntry *entry)
+{
+	(void) day;
+	(void) entry;
+}
+
+#endif /* AOC_CACHE */
+
+/* Copies whatever is left of one stream to another, used for replaying the
+ * buffered output of work that finished out of order */
+static AOC_STAT streamCopy(FILE *from, FILE *to)
+{
+	char buf[BUFSIZ];
+	size_t len;
+
+	while ((len = fread(buf, 1, sizeof(buf), from)) > 0)
+	{
+		if (fwrite(buf, 1, len, to) != len)
+		{
+			return AOC_FAILURE;
+		}
+	}
+
+	return (ferror(from) == 0) ? AOC_SUCCESS : AOC_FAILURE;
+}
+
+/* Solves both parts of a single input file and prints the answers to 'out',
+ * or prints the cached answers of an earlier run of the same input. The day
+ * may use up to num_threads threads on it */
+static AOC_STAT runDayFile(const struct aocDay *day, const char *path, 
+	const size_t num_threads, FILE *out)
+{
+	struct aocView input = {0};
+	struct aocCacheEntry entry;
+	AOC_STAT ret = AOC_SUCCESS;
+	char buf[AOC_ACC_DIGITS];
+	void *ctx = NULL;
+
+	AOC_TRACE_BEGIN("load");
+	ret = viewOpen(path, &input);
+	AOC_TRACE_END("load");
+
+	if (ret != AOC_SUCCESS)
+	{
+		fprintf(stderr, "Failed to open file '%s'\n", path);
+
+		return AOC_FAILURE;
+	}
+
+	input.num_threads = AOC_MAX(num_threads, 1);
+
+	if (cacheLoad(day, &input, &entry) == AOC_TRUE)
+	{
+		fprintf(out, day->part_1_fmt, 
+			accFormat(entry.answers[0], buf));
+
+		if (day->Part2 != NULL)
+		{
+			fprintf(out, day->part_2_fmt, 
+				accFormat(entry.answers[1], buf));
+		}
+
+		viewClose(&input);
+
+		return AOC_SUCCESS;
+	}
+
+	AOC_TRACE_BEGIN("parse");
+	ctx = day->Parse(&input);
+	AOC_TRACE_END("parse");
+
+	if (ctx == NULL)
+	{
+		fprintf(stderr, "Failed to parse file '%s'\n", path);
+		viewClose(&input);
+
+		return AOC_FAILURE;
+	}
+
+	AOC_TRACE_BEGIN("part 1");
+
+	if (day->Part1(ctx, &entry.answers[0]) == AOC_SUCCESS)
+	{
+		fprintf(out, day->part_1_fmt, 
+			accFormat(entry.answers[0], buf));
+	}
+	else
+	{
+		fprintf(stderr, "Failed to solve part 1 of '%s'\n", path);
+		ret = AOC_FAILURE;
+	}
+
+	AOC_TRACE_END("part 1");
+
+	if (day->Part2 != NULL)
+	{
+		AOC_TRACE_BEGIN("part 2");
+
+		if (day->Part2(ctx, &entry.answers[1]) == AOC_SUCCESS)
+		{
+			fprintf(out, day->part_2_fmt, 
+				accFormat(entry.answers[1], buf));
+		}
+		else
+		{
+			fprintf(stderr, "Failed to solve part 2 of '%s'\n", 
+				path);
+			ret = AOC_FAILURE;
+		}
+
+		AOC_TRACE_END("part 2");
+	}
+
+	AOC_TRACE_BEGIN("free");
+
+	day->Free(ctx);
+	viewClose(&input);
+	AOC_TRACE_END("free");
+
+	if (ret == AOC_SUCCESS)
+	{
+		cacheStore(day, &entry);
+	}
+
+	return ret;
+}
+
+/* Most temporary files held open at once while running jobs, the jobs are
+ * run in batches of this many so large batches don't exhaust descriptors */
+#define AOC_JOB_BATCH_LEN (256)
+
+/* One input file for a day, run on the worker pool with its answers buffered
+ * to a temporary file until every job before it has been written out */
+struct aocDayJob
+{
+	const struct aocDay *day;
+	const char *path;
+	size_t num_threads;
+	FILE *out;
+	AOC_STAT status;
+};
+
+static void runDayJob(void *arg)
+{
+	struct aocDayJob *job = arg;
+
+	job->status = runDayFile(job->day, job->path, job->num_threads, 
+		job->out);
+}
+
+/* Runs every job on the pool and writes their output to 'out' in the order
+ * they were given regardless of the order they finished in, optionally with
+ * a heading naming the day and file ahead of each. The num_threads asked for
+ * are shared out between the jobs running at once, so a job only gets more
+ * than its own worker when there are fewer jobs than threads */
+static AOC_STAT runDayJobs(struct aocPool *pool, struct aocDayJob *jobs,
+	const size_t num_jobs, const size_t num_threads, FILE *out, 
+	const AOC_BOOL headings)
+{
+	const size_t share = AOC_MAX(num_threads 
+		/ AOC_MAX(AOC_MIN(num_threads, num_jobs), 1), 1);
+	AOC_STAT ret = AOC_SUCCESS;
+	size_t batch, i;
+
+	for (batch = 0; batch < num_jobs; batch += AOC_JOB_BATCH_LEN)
+	{
+		const size_t end = AOC_MIN(batch + AOC_JOB_BATCH_LEN, num_jobs);
+
+		for (i = batch; i < end; i++)
+		{
+			jobs[i].status = AOC_FAILURE;
+			jobs[i].num_threads = share;
+
+			if ((jobs[i].out = tmpfile()) == NULL)
+			{
+				fprintf(stderr, 
+					"Unable to buffer output for '%s'\n",
+					jobs[i].path);
+
+				continue;
+			}
+
+			poolSubmit(pool, runDayJob, &jobs[i]);
+		}
+
+		poolWait(pool);
+
+		for (i = batch; i < end; i++)
+		{
+			if (jobs[i].out == NULL)
+			{
+				ret = AOC_FAILURE;
+
+				continue;
+			}
+
+			if (headings == AOC_TRUE)
+			{
+				fprintf(out, "Day %d: %s\n", 
+					jobs[i].day->number, jobs[i].path);
+			}
+
+			rewind(jobs[i].out);
+
+			if ((streamCopy(jobs[i].out, out) != AOC_SUCCESS)
+			|| (jobs[i].status != AOC_SUCCESS))
+			{
+				ret = AOC_FAILURE;
+			}
+
+			fclose(jobs[i].out);
+			jobs[i].out = NULL;
+		}
+	}
+
+	return ret;
+}
+
+static void reportThroughput(const size_t num_files, const double secs)
+{
+	fprintf(stderr, "%lu files in %.3f s, %.1f files/s\n",
+		(unsigned long int) num_files, secs,
+		(secs > 0.0) ? num_files / secs : 0.0);
+}
+
+/* Accepts "-j N" ahead of the files, returning how many arguments it used or
+ * -1 if the thread count isn't usable */
+static int parseThreadsOption(int argc, char **argv, size_t *num_threads)
+{
+	char *end = NULL;
+	long int val;
+
+	if ((argc < 2) || (strcmp(argv[1], "-j") != 0))
+	{
+		return 0;
+	}
+
+	if (argc < 3)
+	{
+		return -1;
+	}
+
+	val = strtol(argv[2], &end, 10);
+
+	if ((end == argv[2]) || (*end != '\0') || (val < 1))
+	{
+		return -1;
+	}
+
+	*num_threads = val;
+
+	return 2;
+}
+
+/* Stdin can only be read once so it can only be given as one of the inputs */
+static AOC_STAT checkStdinPaths(char **paths, const int num_paths)
+{
+	int seen = 0;
+	int i;
+
+	for (i = 0; i < num_paths; i++)
+	{
+		seen += AOC_IS_STDIN_PATH(paths[i]);
+	}
+
+	if (seen > 1)
+	{
+		fputs("Stdin ('-') can only be given once\n", stderr);
+
+		return AOC_FAILURE;
+	}
+
+	return AOC_SUCCESS;
+}
+
+/* The body of every day's main, each argument is an input file to solve or
+ * "-" for stdin. The files are solved one after another, each free to use
+ * every processor, unless "-j N" asks for them to be spread across N 
+ * workers, in which case the throughput is reported on stderr */
+static int runDayMain(const struct aocDay *day, int argc, char **argv)
+{
+	struct aocDayJob *jobs = NULL;
+	struct aocPool *pool = NULL;
+	size_t num_threads = 0;
+	size_t num_jobs;
+	int ret = AOC_SUCCESS;
+	double start;
+	int first;
+	int i;
+
+	if ((first = parseThreadsOption(argc, argv, &num_threads) + 1) < 1)
+	{
+		fputs("Please give a thread count of at least 1 to -j\n", 
+			stderr);
+
+		return AOC_FAILURE;
+	}
+
+	if (argc <= first)
+	{
+		fputs("Please provide a file or files to act upon, or - for "
+			"stdin\n", stderr);
+
+		return AOC_FAILURE;
+	}
+
+	if (checkStdinPaths(argv + first, argc - first) != AOC_SUCCESS)
+	{
+		return AOC_FAILURE;
+	}
+
+	if (num_threads == 0)
+	{
+		for (i = first; i < argc; i++)
+		{
+			if (runDayFile(day, argv[i], poolDefaultThreads(), 
+				stdout) != AOC_SUCCESS)
+			{
+				ret = AOC_FAILURE;
+			}
+		}
+
+		return ret;
+	}
+
+	num_jobs = argc - first;
+
+	if (((jobs = malloc(sizeof(struct aocDayJob) * num_jobs)) == NULL)
+	|| ((pool = poolCreate(AOC_MIN(num_threads, num_jobs))) == NULL))
+	{
+		AOC_FREE(jobs);
+
+		return AOC_FAILURE;
+	}
+
+	for (i = first; i < argc; i++)
+	{
+		jobs[i - first].day = day;
+		jobs[i - first].path = argv[i];
+	}
+
+	start = clockSeconds();
+	ret = runDayJobs(pool, jobs, num_jobs, num_threads, stdout, 
+		AOC_FALSE);
+	reportThroughput(num_jobs, clockSeconds() - start);
+	poolDestroy(pool);
+	AOC_FREE(jobs);
+
+	return ret;
 }
 
 #if defined(__GNUC__)
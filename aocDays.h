@@ -0,0 +1,49 @@
+#ifndef AOC_DAYS_H
+#define AOC_DAYS_H
+
+#include "aocCommon.h"
+
+/* Every day's solver, each defined by its own day_XX/main.c. Linking several
+ * days into one program needs them built with -DAOC_NO_MAIN so that only the
+ * driver's main is left */
+extern const struct aocDay aoc_day_01;
+extern const struct aocDay aoc_day_02;
+extern const struct aocDay aoc_day_03;
+extern const struct aocDay aoc_day_04;
+extern const struct aocDay aoc_day_05;
+extern const struct aocDay aoc_day_06;
+extern const struct aocDay aoc_day_07;
+extern const struct aocDay aoc_day_08;
+extern const struct aocDay aoc_day_09;
+extern const struct aocDay aoc_day_10;
+extern const struct aocDay aoc_day_11;
+extern const struct aocDay aoc_day_12;
+extern const struct aocDay aoc_day_13;
+extern const struct aocDay aoc_day_14;
+
+#define AOC_NUM_DAYS (14)
+
+/* Returns NULL for days that haven't been solved */
+static const struct aocDay* dayLookup(const int number)
+{
+	static const struct aocDay * const days[AOC_NUM_DAYS] =
+	{
+		&aoc_day_01, &aoc_day_02, &aoc_day_03, &aoc_day_04,
+		&aoc_day_05, &aoc_day_06, &aoc_day_07, &aoc_day_08,
+		&aoc_day_09, &aoc_day_10, &aoc_day_11, &aoc_day_12,
+		&aoc_day_13, &aoc_day_14
+	};
+
+	if ((number < 1) || (number > AOC_NUM_DAYS))
+	{
+		return NULL;
+	}
+
+	return days[number - 1];
+}
+
+#endif /* AOC_DAYS_H */
+
+/*
+Copyright (c) 2024, grauho <grauho@proton.me> All rights reserved.
+*/
@@ -0,0 +1,696 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(AOC_USE_PERF)
+#include <errno.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif /* AOC_USE_PERF */
+
+#include "../aocDays.h"
+
+/* Times the parse, part 1, and part 2 phases of a day separately over a
+ * number of repetitions after some untimed warmup runs. Each phase is
+ * reported as the min, median, and 99th percentile of its wall time along
+ * with the input throughput at the median, as either CSV or JSON. All of the
+ * days are linked in so it is built as:
+ *
+ * cc -ansi -pedantic -O2 -DAOC_NO_MAIN -DAOC_USE_MONOTONIC \
+ *	-D_POSIX_C_SOURCE=200112L bench/bench.c day_??/main.c -o aoc-bench
+ *
+ * usage: aoc-bench [-n reps] [-w warmup] [-f csv|json] [-p] day file ...
+ *
+ * With -p each phase is also measured with hardware performance counters,
+ * adding the mean cycles, instructions, L1 data cache read misses, last
+ * level cache misses, and branch misses per run along with the IPC and the
+ * misses per input byte. Work the days hand to worker threads is counted
+ * too. The counters come from Linux's perf_event_open, so
+ * the harness has to be built with -DAOC_USE_PERF -D_GNU_SOURCE for them. A
+ * counter the machine or its permissions don't allow is left blank rather
+ * than failing the run */
+#define DEFAULT_REPS   (20)
+#define DEFAULT_WARMUP (2)
+
+enum benchPhase
+{
+	PHASE_PARSE = 0,
+	PHASE_PART_1,
+	PHASE_PART_2,
+	PHASE_NUM
+};
+
+static const char * const phase_names[PHASE_NUM] =
+{
+	"parse", "part1", "part2"
+};
+
+enum benchFormat
+{
+	FORMAT_CSV = 0,
+	FORMAT_JSON
+};
+
+enum benchCounter
+{
+	COUNTER_CYCLES = 0,
+	COUNTER_INSTRUCTIONS,
+	COUNTER_L1D_MISSES,
+	COUNTER_LLC_MISSES,
+	COUNTER_BRANCH_MISSES,
+	COUNTER_NUM
+};
+
+/* The raw counts followed by the figures derived from them */
+enum benchCounterField
+{
+	FIELD_IPC = COUNTER_NUM,
+	FIELD_L1D_PER_BYTE,
+	FIELD_LLC_PER_BYTE,
+	FIELD_BRANCH_PER_BYTE,
+	FIELD_NUM
+};
+
+static const char * const field_names[FIELD_NUM] =
+{
+	"cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses",
+	"ipc", "l1d_misses_per_byte", "llc_misses_per_byte",
+	"branch_misses_per_byte"
+};
+
+static const char * const field_formats[FIELD_NUM] =
+{
+	"%.0f", "%.0f", "%.0f", "%.0f", "%.0f", "%.3f", "%.6f", "%.6f", "%.6f"
+};
+
+/* Counters are opened as one group so that they are all scheduled together,
+ * led by the first of them that could be opened */
+struct benchCounters
+{
+	int fds[COUNTER_NUM]; /* -1 for counters that couldn't be opened */
+	int leader;
+};
+
+struct benchPhaseStats
+{
+	double min;
+	double median;
+	double p99;
+	AOC_ACC answer;
+	AOC_BOOL is_valid;
+	double counts[COUNTER_NUM]; /* Mean per run, negative if unavailable */
+};
+
+static int compareDoubles(const void *left, const void *right)
+{
+	const double foo = *(const double *) left;
+	const double bar = *(const double *) right;
+
+	return (foo > bar) - (foo < bar);
+}
+
+/* Nearest rank percentile of already sorted samples */
+static double percentile(const double *sorted, const size_t len,
+	const int pct)
+{
+	size_t rank = ((len * pct) + 99) / 100;
+
+	return sorted[(rank == 0) ? 0 : rank - 1];
+}
+
+#if defined(AOC_USE_PERF)
+static int openCounter(const enum benchCounter counter, const int leader)
+{
+	static const struct
+	{
+		unsigned int type;
+		unsigned long int config;
+	} events[COUNTER_NUM] =
+	{
+		{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+		{PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+		{PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D
+			| (PERF_COUNT_HW_CACHE_OP_READ << 8)
+			| (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+		{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+		{PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES}
+	};
+	struct perf_event_attr attr;
+
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = events[counter].type;
+	attr.config = events[counter].config;
+	attr.disabled = (leader == -1);
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	attr.inherit = 1;
+
+	/* This thread and the threads it starts from now on, like the pools
+	 * the days start for their phases, on any cpu. Each counter is read
+	 * on its own since the kernel refuses group reads of inherited
+	 * counters */
+	return syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0);
+}
+#endif /* AOC_USE_PERF */
+
+/* Opens whichever counters are available, failing only when none are */
+static AOC_STAT countersOpen(struct benchCounters *counters)
+{
+	size_t i;
+
+	counters->leader = -1;
+
+	for (i = 0; i < COUNTER_NUM; i++)
+	{
+		counters->fds[i] = -1;
+	}
+
+#if defined(AOC_USE_PERF)
+	for (i = 0; i < COUNTER_NUM; i++)
+	{
+		if ((counters->fds[i] = openCounter(i, counters->leader)) == -1)
+		{
+			fprintf(stderr, "Counter %s is unavailable: %s\n",
+				field_names[i], strerror(errno));
+		}
+		else if (counters->leader == -1)
+		{
+			counters->leader = counters->fds[i];
+		}
+	}
+#else
+	fputs("Counters need the harness built with -DAOC_USE_PERF\n", 
+		stderr);
+#endif /* AOC_USE_PERF */
+
+	return (counters->leader == -1) ? AOC_FAILURE : AOC_SUCCESS;
+}
+
+static void countersClose(struct benchCounters *counters)
+{
+#if defined(AOC_USE_PERF)
+	size_t i;
+
+	for (i = 0; i < COUNTER_NUM; i++)
+	{
+		if (counters->fds[i] != -1)
+		{
+			close(counters->fds[i]);
+			counters->fds[i] = -1;
+		}
+	}
+
+	counters->leader = -1;
+#else
+	(void) counters;
+#endif /* AOC_USE_PERF */
+}
+
+#if defined(AOC_USE_PERF)
+/* Adds each counter's current value times 'sign' to 'counts'. Resetting
+ * the counters doesn't clear what threads that have since exited added to
+ * them, so a phase is measured as the difference of two reads instead */
+static void countersRead(const struct benchCounters *counters, 
+	double *counts, const double sign)
+{
+	size_t i;
+
+	for (i = 0; i < COUNTER_NUM; i++)
+	{
+		__u64 value;
+
+		if ((counters->fds[i] != -1) && (read(counters->fds[i], 
+			&value, sizeof(value)) == sizeof(value)))
+		{
+			counts[i] += sign * (double) value;
+		}
+	}
+}
+#endif /* AOC_USE_PERF */
+
+static void countersStart(const struct benchCounters *counters,
+	double *counts)
+{
+#if defined(AOC_USE_PERF)
+	if ((counters != NULL) && (counters->leader != -1))
+	{
+		countersRead(counters, counts, -1.0);
+		ioctl(counters->leader, PERF_EVENT_IOC_ENABLE, 
+			PERF_IOC_FLAG_GROUP);
+	}
+#else
+	(void) counters;
+	(void) counts;
+#endif /* AOC_USE_PERF */
+}
+
+/* Adds the counts since countersStart to 'counts' */
+static void countersStop(const struct benchCounters *counters, 
+	double *counts)
+{
+#if defined(AOC_USE_PERF)
+	if ((counters != NULL) && (counters->leader != -1))
+	{
+		ioctl(counters->leader, PERF_EVENT_IOC_DISABLE, 
+			PERF_IOC_FLAG_GROUP);
+		countersRead(counters, counts, 1.0);
+	}
+#else
+	(void) counters;
+	(void) counts;
+#endif /* AOC_USE_PERF */
+}
+
+/* Runs every phase of the day once, storing how long each took and adding
+ * up the counters when there are any. When 'times' is NULL the run is only
+ * for warming up */
+static AOC_STAT benchOnce(const struct aocDay *day,
+	const struct aocView *input, double *times, AOC_ACC *answers,
+	const struct benchCounters *counters, 
+	double counts[PHASE_NUM][COUNTER_NUM])
+{
+	AOC_STAT ret = AOC_SUCCESS;
+	double start, end;
+	void *ctx = NULL;
+
+	if (times == NULL)
+	{
+		counters = NULL;
+	}
+
+	countersStart(counters, counts[PHASE_PARSE]);
+	start = clockSeconds();
+	ctx = day->Parse(input);
+	end = clockSeconds();
+	countersStop(counters, counts[PHASE_PARSE]);
+
+	if (ctx == NULL)
+	{
+		return AOC_FAILURE;
+	}
+
+	if (times != NULL)
+	{
+		times[PHASE_PARSE] = end - start;
+	}
+
+	countersStart(counters, counts[PHASE_PART_1]);
+	start = clockSeconds();
+
+	if (day->Part1(ctx, &answers[PHASE_PART_1]) != AOC_SUCCESS)
+	{
+		ret = AOC_FAILURE;
+	}
+
+	end = clockSeconds();
+	countersStop(counters, counts[PHASE_PART_1]);
+
+	if (times != NULL)
+	{
+		times[PHASE_PART_1] = end - start;
+	}
+
+	if (day->Part2 != NULL)
+	{
+		countersStart(counters, counts[PHASE_PART_2]);
+		start = clockSeconds();
+
+		if (day->Part2(ctx, &answers[PHASE_PART_2]) != AOC_SUCCESS)
+		{
+			ret = AOC_FAILURE;
+		}
+
+		end = clockSeconds();
+		countersStop(counters, counts[PHASE_PART_2]);
+
+		if (times != NULL)
+		{
+			times[PHASE_PART_2] = end - start;
+		}
+	}
+
+	day->Free(ctx);
+
+	return ret;
+}
+
+static AOC_STAT benchFile(const struct aocDay *day,
+	const struct aocView *input, const size_t reps, const size_t warmup,
+	const struct benchCounters *counters,
+	struct benchPhaseStats stats[PHASE_NUM])
+{
+	double *samples[PHASE_NUM] = {NULL};
+	double counts[PHASE_NUM][COUNTER_NUM] = {{0}};
+	AOC_ACC answers[PHASE_NUM] = {0};
+	double times[PHASE_NUM] = {0};
+	AOC_STAT ret = AOC_SUCCESS;
+	size_t i, j;
+
+	for (i = 0; i < PHASE_NUM; i++)
+	{
+		AOC_NEW_DYN_ARR(double, samples[i], reps);
+	}
+
+	for (i = 0; (i < warmup) && (ret == AOC_SUCCESS); i++)
+	{
+		ret = benchOnce(day, input, NULL, answers, counters, counts);
+	}
+
+	for (i = 0; (i < reps) && (ret == AOC_SUCCESS); i++)
+	{
+		ret = benchOnce(day, input, times, answers, counters, counts);
+
+		for (j = 0; j < PHASE_NUM; j++)
+		{
+			samples[j][i] = times[j];
+		}
+	}
+
+	for (i = 0; (i < PHASE_NUM) && (ret == AOC_SUCCESS); i++)
+	{
+		qsort(samples[i], reps, sizeof(double), compareDoubles);
+		stats[i].min = samples[i][0];
+		stats[i].median = percentile(samples[i], reps, 50);
+		stats[i].p99 = percentile(samples[i], reps, 99);
+		stats[i].answer = answers[i];
+		stats[i].is_valid = ((i != PHASE_PART_2)
+			|| (day->Part2 != NULL));
+
+		for (j = 0; j < COUNTER_NUM; j++)
+		{
+			stats[i].counts[j] = ((counters != NULL)
+				&& (counters->fds[j] != -1))
+				? counts[i][j] / reps
+				: -1.0;
+		}
+	}
+
+	for (i = 0; i < PHASE_NUM; i++)
+	{
+		AOC_FREE(samples[i]);
+	}
+
+	return ret;
+}
+
+/* Paths are the only free-form text that ends up in the output */
+static void printJSONString(FILE *out, const char *str)
+{
+	fputc('"', out);
+
+	for (; *str != '\0'; str++)
+	{
+		if ((*str == '"') || (*str == '\\'))
+		{
+			fputc('\\', out);
+			fputc(*str, out);
+		}
+		else if ((unsigned char) *str < 0x20)
+		{
+			fprintf(out, "\\u%04x", (unsigned int) *str);
+		}
+		else
+		{
+			fputc(*str, out);
+		}
+	}
+
+	fputc('"', out);
+}
+
+static double perByte(const double count, const size_t input_len)
+{
+	return ((count < 0.0) || (input_len == 0)) ? -1.0 : count / input_len;
+}
+
+/* Unavailable counters, and anything derived from them, are left blank in
+ * CSV and null in JSON */
+static void printCounters(FILE *out, const enum benchFormat format,
+	const struct benchPhaseStats *stats, const size_t input_len)
+{
+	double fields[FIELD_NUM];
+	size_t i;
+
+	for (i = 0; i < COUNTER_NUM; i++)
+	{
+		fields[i] = stats->counts[i];
+	}
+
+	fields[FIELD_IPC] = ((stats->counts[COUNTER_CYCLES] > 0.0)
+		&& (stats->counts[COUNTER_INSTRUCTIONS] >= 0.0))
+		? stats->counts[COUNTER_INSTRUCTIONS] 
+			/ stats->counts[COUNTER_CYCLES]
+		: -1.0;
+	fields[FIELD_L1D_PER_BYTE] = perByte(stats->counts[COUNTER_L1D_MISSES],
+		input_len);
+	fields[FIELD_LLC_PER_BYTE] = perByte(stats->counts[COUNTER_LLC_MISSES],
+		input_len);
+	fields[FIELD_BRANCH_PER_BYTE] 
+		= perByte(stats->counts[COUNTER_BRANCH_MISSES], input_len);
+
+	for (i = 0; i < FIELD_NUM; i++)
+	{
+		if (format == FORMAT_CSV)
+		{
+			fputc(',', out);
+		}
+		else
+		{
+			fprintf(out, ", \"%s\": ", field_names[i]);
+		}
+
+		if (fields[i] >= 0.0)
+		{
+			fprintf(out, field_formats[i], fields[i]);
+		}
+		else if (format == FORMAT_JSON)
+		{
+			fputs("null", out);
+		}
+	}
+}
+
+static void printStats(FILE *out, const enum benchFormat format,
+	const int day_number, const char *path, const size_t input_len,
+	const size_t reps, const struct benchPhaseStats stats[PHASE_NUM],
+	const AOC_BOOL with_counters, AOC_BOOL *first_record)
+{
+	char buf[AOC_ACC_DIGITS];
+	size_t i;
+
+	for (i = 0; i < PHASE_NUM; i++)
+	{
+		const double throughput = (stats[i].median > 0.0)
+			? (double) input_len / stats[i].median
+			: 0.0;
+
+		if (stats[i].is_valid == AOC_FALSE)
+		{
+			continue;
+		}
+
+		if (format == FORMAT_CSV)
+		{
+			fprintf(out, "%d,%s,%s,%lu,%lu,%.9f,%.9f,%.9f,%.0f,",
+				day_number, path, phase_names[i],
+				(unsigned long int) input_len,
+				(unsigned long int) reps, stats[i].min,
+				stats[i].median, stats[i].p99, throughput);
+
+			if (i != PHASE_PARSE)
+			{
+				fputs(accFormat(stats[i].answer, buf), out);
+			}
+
+			if (with_counters == AOC_TRUE)
+			{
+				printCounters(out, format, &stats[i], 
+					input_len);
+			}
+
+			fputc('\n', out);
+		}
+		else
+		{
+			fprintf(out, "%s\n  {\"day\": %d, \"file\": ",
+				(*first_record == AOC_TRUE) ? "" : ",",
+				day_number);
+			printJSONString(out, path);
+			fprintf(out, ", \"phase\": \"%s\", \"bytes\": %lu, "
+				"\"reps\": %lu, \"min_s\": %.9f, "
+				"\"median_s\": %.9f, \"p99_s\": %.9f, "
+				"\"bytes_per_s\": %.0f",
+				phase_names[i], (unsigned long int) input_len,
+				(unsigned long int) reps, stats[i].min,
+				stats[i].median, stats[i].p99, throughput);
+
+			if (i != PHASE_PARSE)
+			{
+				fprintf(out, ", \"answer\": %s",
+					accFormat(stats[i].answer, buf));
+			}
+
+			if (with_counters == AOC_TRUE)
+			{
+				printCounters(out, format, &stats[i], 
+					input_len);
+			}
+
+			fputc('}', out);
+		}
+
+		*first_record = AOC_FALSE;
+	}
+}
+
+static AOC_STAT parseCount(const char *arg, size_t *out)
+{
+	char *end = NULL;
+	long int val;
+
+	if (arg == NULL)
+	{
+		return AOC_FAILURE;
+	}
+
+	val = strtol(arg, &end, 10);
+
+	if ((end == arg) || (*end != '\0') || (val < 0))
+	{
+		return AOC_FAILURE;
+	}
+
+	*out = val;
+
+	return AOC_SUCCESS;
+}
+
+int main(int argc, char **argv)
+{
+	enum benchFormat format = FORMAT_CSV;
+	const struct aocDay *day = NULL;
+	struct benchCounters counters;
+	AOC_BOOL with_counters = AOC_FALSE;
+	AOC_BOOL first_record = AOC_TRUE;
+	size_t reps = DEFAULT_REPS;
+	size_t warmup = DEFAULT_WARMUP;
+	int ret = AOC_SUCCESS;
+	int i;
+
+	for (i = 1; (i < argc) && (argv[i][0] == '-'); i++)
+	{
+		if ((strcmp(argv[i], "-n") == 0)
+		&& (parseCount(argv[i + 1], &reps) == AOC_SUCCESS)
+		&& (reps > 0))
+		{
+			i++;
+		}
+		else if ((strcmp(argv[i], "-w") == 0)
+		&& (parseCount(argv[i + 1], &warmup) == AOC_SUCCESS))
+		{
+			i++;
+		}
+		else if ((strcmp(argv[i], "-f") == 0) && (i + 1 < argc)
+		&& ((strcmp(argv[i + 1], "csv") == 0)
+			|| (strcmp(argv[i + 1], "json") == 0)))
+		{
+			format = (argv[i + 1][0] == 'j')
+				? FORMAT_JSON
+				: FORMAT_CSV;
+			i++;
+		}
+		else if (strcmp(argv[i], "-p") == 0)
+		{
+			with_counters = AOC_TRUE;
+		}
+		else
+		{
+			fprintf(stderr, "Unrecognized option '%s'\n", argv[i]);
+
+			return AOC_FAILURE;
+		}
+	}
+
+	if ((i + 1 >= argc) || ((day = dayLookup(atoi(argv[i]))) == NULL))
+	{
+		fputs("usage: aoc-bench [-n reps] [-w warmup] [-f csv|json] "
+			"[-p] day file [file ...]\n", stderr);
+
+		return AOC_FAILURE;
+	}
+
+	/* Without any counters the columns are still there, only blank */
+	if ((with_counters == AOC_TRUE) 
+	&& (countersOpen(&counters) != AOC_SUCCESS))
+	{
+		fputs("No performance counters available\n", stderr);
+	}
+
+	if (format == FORMAT_CSV)
+	{
+		size_t j;
+
+		fputs("day,file,phase,bytes,reps,min_s,median_s,p99_s,"
+			"bytes_per_s,answer", stdout);
+
+		for (j = 0; (j < FIELD_NUM) && (with_counters == AOC_TRUE); 
+			j++)
+		{
+			fprintf(stdout, ",%s", field_names[j]);
+		}
+
+		fputc('\n', stdout);
+	}
+	else
+	{
+		fputc('[', stdout);
+	}
+
+	for (i++; i < argc; i++)
+	{
+		struct benchPhaseStats stats[PHASE_NUM];
+		struct aocView input = {0};
+
+		if (viewOpen(argv[i], &input) != AOC_SUCCESS)
+		{
+			fprintf(stderr, "Failed to open file '%s'\n", argv[i]);
+			ret = AOC_FAILURE;
+
+			continue;
+		}
+
+		/* One input is timed at a time, as a day run on it alone */
+		input.num_threads = poolDefaultThreads();
+
+		if (benchFile(day, &input, reps, warmup, 
+			(with_counters == AOC_TRUE) ? &counters : NULL, stats)
+			!= AOC_SUCCESS)
+		{
+			fprintf(stderr, "Failed to solve file '%s'\n", argv[i]);
+			ret = AOC_FAILURE;
+		}
+		else
+		{
+			printStats(stdout, format, day->number, argv[i],
+				input.len, reps, stats, with_counters, 
+				&first_record);
+		}
+
+		viewClose(&input);
+	}
+
+	if (format == FORMAT_JSON)
+	{
+		fputs("\n]\n", stdout);
+	}
+
+	if (with_counters == AOC_TRUE)
+	{
+		countersClose(&counters);
+	}
+
+	return ret;
+}
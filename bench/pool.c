@@ -0,0 +1,141 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../aocCommon.h"
+
+/* Measures how poolParallelFor scales from one worker up to the given number
+ * of them, the number of processors online by default. The work is counting
+ * the Collatz steps of every number in the range, which varies enough from
+ * one index to the next that the workers only stay busy by stealing. Every
+ * run has to agree on the total. The length is given in millions, eg:
+ *
+ * cc -ansi -pedantic -O2 -DAOC_USE_THREADS -DAOC_USE_MONOTONIC \
+ *	-D_POSIX_C_SOURCE=200112L -pthread bench/pool.c -o aoc-pool
+ * ./aoc-pool 20 8 */
+#define DEFAULT_MILLIONS (10)
+
+static void collatzBody(void *ctx, size_t begin, size_t end, size_t slot)
+{
+	union aocPoolSum *sums = ctx;
+	AOC_ACC steps = 0;
+	size_t i;
+
+	for (i = begin; i < end; i++)
+	{
+		unsigned long int val = i + 1;
+
+		while (val != 1)
+		{
+			val = (val & 1) ? (val * 3) + 1 : val >> 1;
+			steps++;
+		}
+	}
+
+	sums[slot].sum += steps;
+}
+
+static AOC_STAT runWorkers(const size_t num_threads, const size_t len,
+	double *secs, AOC_ACC *total)
+{
+	struct aocPool *pool = NULL;
+	union aocPoolSum *sums = NULL;
+	AOC_STAT ret;
+	double start;
+	size_t i;
+
+	if ((pool = poolCreate(num_threads)) == NULL)
+	{
+		return AOC_FAILURE;
+	}
+
+	if ((sums = calloc(poolNumSlots(pool), sizeof(union aocPoolSum)))
+		== NULL)
+	{
+		poolDestroy(pool);
+
+		return AOC_FAILURE;
+	}
+
+	start = clockSeconds();
+	ret = poolParallelFor(pool, 0, len, 0, collatzBody, sums);
+	*secs = clockSeconds() - start;
+	*total = 0;
+
+	for (i = 0; i < poolNumSlots(pool); i++)
+	{
+		*total += sums[i].sum;
+	}
+
+	AOC_FREE(sums);
+	poolDestroy(pool);
+
+	return ret;
+}
+
+int main(int argc, char **argv)
+{
+	size_t millions = DEFAULT_MILLIONS;
+	size_t max_threads = poolDefaultThreads();
+	double base_secs = 0.0;
+	AOC_ACC base_total = 0;
+	char buf[AOC_ACC_DIGITS];
+	size_t threads;
+
+	if (argc > 1)
+	{
+		millions = strtoul(argv[1], NULL, 10);
+	}
+
+	if (argc > 2)
+	{
+		max_threads = strtoul(argv[2], NULL, 10);
+	}
+
+	if ((millions == 0) || (max_threads == 0))
+	{
+		fputs("usage: aoc-pool [millions] [max threads]\n", stderr);
+
+		return AOC_FAILURE;
+	}
+
+	fprintf(stdout, "%7s %10s %8s %10s %s\n", "threads", "seconds",
+		"speedup", "efficiency", "total steps");
+
+	/* Doubles the workers each run and finishes on the maximum */
+	for (threads = 1; ; threads = AOC_MIN(threads * 2, max_threads))
+	{
+		double secs;
+		AOC_ACC total;
+
+		if (runWorkers(threads, millions * 1000000, &secs, &total)
+			!= AOC_SUCCESS)
+		{
+			fprintf(stderr, "Unable to run on %lu threads\n",
+				(unsigned long int) threads);
+
+			return AOC_FAILURE;
+		}
+
+		if (threads == 1)
+		{
+			base_secs = secs;
+			base_total = total;
+		}
+
+		fprintf(stdout, "%7lu %10.3f %7.2fx %9.1f%% %s%s\n",
+			(unsigned long int) threads, secs,
+			(secs > 0.0) ? base_secs / secs : 0.0,
+			(secs > 0.0) ? (100.0 * base_secs) / (secs * threads)
+				: 0.0,
+			accFormat(total, buf),
+			(total == base_total) ? "" : " (MISMATCH)");
+
+		if (threads == max_threads)
+		{
+			break;
+		}
+	}
+
+	return AOC_SUCCESS;
+}
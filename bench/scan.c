@@ -0,0 +1,166 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../aocCommon.h"
+
+/* Compares the throughput of the shared cursor scanner against the sscanf and
+ * strtol parsing it replaced. The input is generated in memory as lines of two
+ * five digit values in the same layout as the day 1 lists so that disk speed
+ * plays no part in the result. The size is given in megabytes, eg: 1024 for
+ * the 1 GB run */
+#define DEFAULT_MB (64)
+#define LINE_LEN   (sizeof("12345   67890\n") - 1)
+
+static char* generateInput(const size_t len)
+{
+	unsigned long int seed = 12345;
+	char *buf = NULL;
+	size_t i;
+
+	buf = malloc(len + 1);
+
+	if (buf == NULL)
+	{
+		return NULL;
+	}
+
+	for (i = 0; i + LINE_LEN <= len; i += LINE_LEN)
+	{
+		long int left;
+		long int right;
+
+		seed = (seed * 1103515245ul + 12345ul) & 0x7FFFFFFFul;
+		left = 10000 + (long int) (seed % 90000);
+		seed = (seed * 1103515245ul + 12345ul) & 0x7FFFFFFFul;
+		right = 10000 + (long int) (seed % 90000);
+		sprintf(buf + i, "%5ld   %5ld\n", left, right);
+	}
+
+	buf[i] = '\0';
+
+	return buf;
+}
+
+/* What the days did originally, each line is copied out as fgets would and
+ * then handed to sscanf */
+static long int benchSscanf(const struct aocView *input)
+{
+	char line_buf[64];
+	const char *line = NULL;
+	size_t line_len;
+	size_t cursor = 0;
+	long int sum = 0;
+
+	while (viewNextLine(input, &cursor, &line, &line_len) == AOC_TRUE)
+	{
+		long int left;
+		long int right;
+
+		if (line_len >= sizeof(line_buf))
+		{
+			continue;
+		}
+
+		memcpy(line_buf, line, line_len);
+		line_buf[line_len] = '\0';
+
+		if (sscanf(line_buf, "%ld %ld", &left, &right) == 2)
+		{
+			sum += left + right;
+		}
+	}
+
+	return sum;
+}
+
+static long int benchStrtol(const struct aocView *input)
+{
+	const char *pos = input->data;
+	char *end = NULL;
+	long int sum = 0;
+
+	for (;;)
+	{
+		const long int val = strtol(pos, &end, 10);
+
+		if (end == pos)
+		{
+			break;
+		}
+
+		sum += val;
+		pos = end;
+	}
+
+	return sum;
+}
+
+static long int benchScanner(const struct aocView *input)
+{
+	struct aocCursor curs;
+	long int sum = 0;
+	long int val;
+
+	cursorInit(&curs, input->data, input->len);
+
+	while (scanNextLong(&curs, &val) == AOC_SUCCESS)
+	{
+		sum += val;
+	}
+
+	return sum;
+}
+
+static void runBench(const char *name, long int (*func)(const struct aocView*),
+	const struct aocView *input)
+{
+	const clock_t start = clock();
+	const long int sum = func(input);
+	const double secs = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+	fprintf(stdout, "%-8s %8.3f s %10.1f MB/s (checksum %ld)\n", name, secs,
+		(secs > 0.0) ? (input->len / secs) / (1024.0 * 1024.0) : 0.0,
+		sum);
+}
+
+int main(int argc, char **argv)
+{
+	struct aocView input = {0};
+	size_t mb = DEFAULT_MB;
+	char *buf = NULL;
+
+	if (argc > 1)
+	{
+		mb = strtoul(argv[1], NULL, 10);
+	}
+
+	if (mb == 0)
+	{
+		fputs("Please provide a size in megabytes\n", stderr);
+
+		return AOC_FAILURE;
+	}
+
+	buf = generateInput(mb * 1024 * 1024);
+
+	if (buf == NULL)
+	{
+		fprintf(stderr, "Unable to allocate %lu MB\n",
+			(unsigned long int) mb);
+
+		return AOC_FAILURE;
+	}
+
+	input.data = buf;
+	input.len = strlen(buf);
+	input.owned = buf;
+
+	runBench("sscanf", benchSscanf, &input);
+	runBench("strtol", benchStrtol, &input);
+	runBench("scanner", benchScanner, &input);
+	viewClose(&input);
+
+	return AOC_SUCCESS;
+}
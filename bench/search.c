@@ -0,0 +1,189 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../aocCommon.h"
+
+/* Compares the searches over sorted ints: leftBinSearch with its comparator
+ * callback, the standard library's bsearch, the branchless lower bound, and
+ * the prefetching Eytzinger search. Every search answers the same random
+ * queries against a sorted array of random values, given as a list of array
+ * lengths that defaults to 1K, 1M, and 100M elements. Built as:
+ *
+ * cc -ansi -pedantic -O2 -DAOC_USE_MONOTONIC -D_POSIX_C_SOURCE=200112L \
+ *	bench/search.c -o aoc-search */
+#define NUM_QUERIES (4000000)
+#define VALUE_MASK  (0x3FFFFFFFul)
+
+static const size_t default_lens[] = {1000, 1000000, 100000000};
+
+#define INT_LESS(foo, bar) ((foo) < (bar))
+
+AOC_DEFINE_RADIX_SORT(sortInts, int, AOC_RADIX_INT_KEY, sizeof(int))
+AOC_DEFINE_LOWER_BOUND(lowerBoundInts, int, INT_LESS)
+AOC_DEFINE_EYTZINGER(treeInts, int, INT_LESS)
+
+static int compareInts(const void *left, const void *right)
+{
+	const int foo = *(const int *) left;
+	const int bar = *(const int *) right;
+
+	return (foo > bar) - (foo < bar);
+}
+
+static unsigned long int nextValue(unsigned long int *seed)
+{
+	*seed ^= (*seed << 13) & 0xFFFFFFFFul;
+	*seed ^= *seed >> 17;
+	*seed ^= (*seed << 5) & 0xFFFFFFFFul;
+
+	return *seed & VALUE_MASK;
+}
+
+/* The checksums are the sum of the values each search lands on, so the
+ * lower bounds have to agree and bsearch only counts exact matches */
+static void report(const char *name, const size_t len, const double secs,
+	const unsigned long int checksum)
+{
+	fprintf(stdout, "%10lu %-10s %8.1f ns/query (checksum %lu)\n",
+		(unsigned long int) len, name, (secs * 1e9) / NUM_QUERIES,
+		checksum);
+}
+
+static AOC_STAT benchLength(const size_t len, const int *queries)
+{
+	unsigned long int seed = 2463534242ul;
+	unsigned long int checksum;
+	int *sorted = NULL;
+	int *tree = NULL;
+	double start;
+	size_t i;
+
+	if (((sorted = malloc(sizeof(int) * len)) == NULL)
+	|| ((tree = malloc(sizeof(int) * (len + 1))) == NULL))
+	{
+		fprintf(stderr, "Unable to allocate %lu ints\n",
+			(unsigned long int) len);
+		AOC_FREE(sorted);
+
+		return AOC_FAILURE;
+	}
+
+	for (i = 0; i < len; i++)
+	{
+		sorted[i] = nextValue(&seed);
+	}
+
+	sortInts(sorted, len);
+	treeIntsBuild(sorted, tree, len);
+
+	checksum = 0;
+	start = clockSeconds();
+
+	for (i = 0; i < NUM_QUERIES; i++)
+	{
+		const size_t found = leftBinSearch(sorted, len, &queries[i],
+			sizeof(int), compareInts);
+
+		checksum += (found < len) ? sorted[found] : 0;
+	}
+
+	report("leftBin", len, clockSeconds() - start, checksum);
+
+	checksum = 0;
+	start = clockSeconds();
+
+	for (i = 0; i < NUM_QUERIES; i++)
+	{
+		const int *found = bsearch(&queries[i], sorted, len,
+			sizeof(int), compareInts);
+
+		checksum += (found != NULL) ? *found : 0;
+	}
+
+	report("bsearch", len, clockSeconds() - start, checksum);
+
+	checksum = 0;
+	start = clockSeconds();
+
+	for (i = 0; i < NUM_QUERIES; i++)
+	{
+		const size_t found = lowerBoundInts(sorted, len, queries[i]);
+
+		checksum += (found < len) ? sorted[found] : 0;
+	}
+
+	report("branchless", len, clockSeconds() - start, checksum);
+
+	checksum = 0;
+	start = clockSeconds();
+
+	for (i = 0; i < NUM_QUERIES; i++)
+	{
+		const size_t node = treeIntsLowerBound(tree, len, queries[i]);
+
+		checksum += (node != 0) ? tree[node] : 0;
+	}
+
+	report("eytzinger", len, clockSeconds() - start, checksum);
+
+	AOC_FREE(sorted);
+	AOC_FREE(tree);
+
+	return AOC_SUCCESS;
+}
+
+int main(int argc, char **argv)
+{
+	unsigned long int seed = 88172645ul;
+	AOC_STAT ret = AOC_SUCCESS;
+	int *queries = NULL;
+	size_t i;
+
+	if ((queries = malloc(sizeof(int) * NUM_QUERIES)) == NULL)
+	{
+		return AOC_FAILURE;
+	}
+
+	for (i = 0; i < NUM_QUERIES; i++)
+	{
+		queries[i] = nextValue(&seed);
+	}
+
+	if (argc > 1)
+	{
+		for (i = 1; (int) i < argc; i++)
+		{
+			const size_t len = strtoul(argv[i], NULL, 10);
+
+			if (len == 0)
+			{
+				fprintf(stderr, "Invalid length '%s'\n",
+					argv[i]);
+				ret = AOC_FAILURE;
+
+				continue;
+			}
+
+			if (benchLength(len, queries) != AOC_SUCCESS)
+			{
+				ret = AOC_FAILURE;
+			}
+		}
+	}
+	else
+	{
+		for (i = 0; i < sizeof(default_lens) / sizeof(size_t); i++)
+		{
+			if (benchLength(default_lens[i], queries)
+				!= AOC_SUCCESS)
+			{
+				ret = AOC_FAILURE;
+			}
+		}
+	}
+
+	AOC_FREE(queries);
+
+	return ret;
+}
@@ -0,0 +1,247 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../aocCommon.h"
+
+/* Compares ways of scoring the similarity of day 1's lists: the sum of each
+ * left value times how often it appears in the right list. Searching the
+ * sorted right list for every distinct left value is how day 1 used to do
+ * it, merging the two sorted lists is how it does it now, and counting the
+ * right values in a hash map needs no sorting at all so it suits lists that
+ * arrive unsorted, as a stream would. Sorting is timed on its own and along
+ * with the merge so that the last two can be compared on equal terms. Each
+ * length runs on random five digit values like the puzzle's and again on
+ * values that hardly repeat. Lengths are given in millions of lines and
+ * default to 10. The lists and the sort take 12 bytes a line, but the hash
+ * map of values that hardly repeat can take more than 100. Built as:
+ *
+ * cc -ansi -pedantic -O2 -DAOC_USE_MONOTONIC -D_POSIX_C_SOURCE=200112L \
+ *	bench/similarity.c -o aoc-similarity */
+#define DEFAULT_MILLIONS (10)
+
+#define INT_LESS(foo, bar) ((foo) < (bar))
+
+AOC_DEFINE_RADIX_SORT(sortInts, int, AOC_RADIX_INT_KEY, sizeof(int))
+AOC_DEFINE_LOWER_BOUND(lowerBoundInts, int, INT_LESS)
+
+/* Five digit values repeat a lot at these lengths, which keeps the number
+ * of distinct values and so of searches small. Values up to a billion are
+ * nearly all distinct, which is where searching costs the most */
+#define FIVE_DIGIT_SPAN (90000ul)
+#define WIDE_SPAN       (1000000000ul)
+
+static unsigned long int nextValue(unsigned long int *seed,
+	const unsigned long int span)
+{
+	*seed ^= (*seed << 13) & 0xFFFFFFFFul;
+	*seed ^= *seed >> 17;
+	*seed ^= (*seed << 5) & 0xFFFFFFFFul;
+
+	return (span == FIVE_DIGIT_SPAN) ? 10000 + (*seed % span) 
+		: *seed % span;
+}
+
+static AOC_ACC searchScore(const int *left, const int *right,
+	const size_t len)
+{
+	AOC_ACC score = 0;
+	size_t i = 0;
+
+	while (i < len)
+	{
+		const int current = left[i];
+		size_t found = lowerBoundInts(right, len, current);
+		AOC_ACC count = 0;
+
+		while ((found < len) && (right[found] == current))
+		{
+			count++;
+			found++;
+		}
+
+		while ((i < len) && (left[i] == current))
+		{
+			score += current * count;
+			i++;
+		}
+	}
+
+	return score;
+}
+
+static AOC_ACC mergeScore(const int *left, const int *right,
+	const size_t len)
+{
+	AOC_ACC score = 0;
+	size_t i = 0;
+	size_t j = 0;
+
+	while (i < len)
+	{
+		const int current = left[i];
+		const size_t left_start = i;
+		size_t right_start;
+
+		while ((i < len) && (left[i] == current))
+		{
+			i++;
+		}
+
+		while ((j < len) && (right[j] < current))
+		{
+			j++;
+		}
+
+		right_start = j;
+
+		while ((j < len) && (right[j] == current))
+		{
+			j++;
+		}
+
+		score += (AOC_ACC) current * (AOC_ACC) (i - left_start)
+			* (AOC_ACC) (j - right_start);
+	}
+
+	return score;
+}
+
+/* Neither list has to be sorted, the right one is counted as it comes and
+ * the left one only looks up its counts */
+static AOC_ACC hashScore(const int *left, const int *right, const size_t len)
+{
+	struct aocHash counts;
+	AOC_ACC score = 0;
+	size_t slot;
+	size_t i;
+
+	hashInit(&counts, 0, AOC_TRUE);
+
+	for (i = 0; i < len; i++)
+	{
+		if (hashInsert(&counts, AOC_HASH_KEY(right[i]), &slot)
+			== AOC_TRUE)
+		{
+			counts.vals[slot] = 0;
+		}
+
+		counts.vals[slot]++;
+	}
+
+	for (i = 0; i < len; i++)
+	{
+		if (hashFind(&counts, AOC_HASH_KEY(left[i]), &slot) == AOC_TRUE)
+		{
+			score += (AOC_ACC) left[i] * counts.vals[slot];
+		}
+	}
+
+	hashFree(&counts);
+
+	return score;
+}
+
+static void report(const char *name, const size_t len, const double secs,
+	const AOC_ACC score, const AOC_ACC expected)
+{
+	char buf[AOC_ACC_DIGITS];
+
+	fprintf(stdout, "%10lu %-12s %8.3f s %8.2f ns/line %s%s\n",
+		(unsigned long int) len, name, secs, (secs * 1e9) / len,
+		accFormat(score, buf),
+		(score == expected) ? "" : " (MISMATCH)");
+}
+
+static AOC_STAT benchLength(const size_t millions,
+	const unsigned long int span)
+{
+	const size_t len = millions * 1000000;
+	unsigned long int seed = 2463534242ul;
+	int *left = NULL;
+	int *right = NULL;
+	AOC_ACC expected, score;
+	double start, sort_secs, merge_secs;
+	size_t i;
+
+	if (((left = malloc(sizeof(int) * len)) == NULL)
+	|| ((right = malloc(sizeof(int) * len)) == NULL))
+	{
+		fprintf(stderr, "Unable to allocate %lu M lines\n",
+			(unsigned long int) millions);
+		AOC_FREE(left);
+
+		return AOC_FAILURE;
+	}
+
+	for (i = 0; i < len; i++)
+	{
+		left[i] = nextValue(&seed, span);
+		right[i] = nextValue(&seed, span);
+	}
+
+	start = clockSeconds();
+	expected = hashScore(left, right, len);
+	report("hash", len, clockSeconds() - start, expected, expected);
+
+	start = clockSeconds();
+	sortInts(left, len);
+	sortInts(right, len);
+	sort_secs = clockSeconds() - start;
+	fprintf(stdout, "%10lu %-12s %8.3f s %8.2f ns/line\n",
+		(unsigned long int) len, "sort", sort_secs,
+		(sort_secs * 1e9) / len);
+
+	start = clockSeconds();
+	score = searchScore(left, right, len);
+	report("search", len, clockSeconds() - start, score, expected);
+
+	start = clockSeconds();
+	score = mergeScore(left, right, len);
+	merge_secs = clockSeconds() - start;
+	report("merge", len, merge_secs, score, expected);
+	report("sort + merge", len, sort_secs + merge_secs, score, expected);
+
+	AOC_FREE(left);
+	AOC_FREE(right);
+
+	return AOC_SUCCESS;
+}
+
+int main(int argc, char **argv)
+{
+	AOC_STAT ret = AOC_SUCCESS;
+	int i;
+
+	for (i = 1; (i < argc) || (i == 1); i++)
+	{
+		const size_t millions = (argc < 2) ? DEFAULT_MILLIONS 
+			: strtoul(argv[i], NULL, 10);
+
+		if (millions == 0)
+		{
+			fprintf(stderr, "Invalid length '%s'\n", argv[i]);
+			ret = AOC_FAILURE;
+
+			continue;
+		}
+
+		fprintf(stdout, "%lu M lines of five digit values\n",
+			(unsigned long int) millions);
+
+		if (benchLength(millions, FIVE_DIGIT_SPAN) != AOC_SUCCESS)
+		{
+			ret = AOC_FAILURE;
+		}
+
+		fprintf(stdout, "%lu M lines of values up to a billion\n",
+			(unsigned long int) millions);
+
+		if (benchLength(millions, WIDE_SPAN) != AOC_SUCCESS)
+		{
+			ret = AOC_FAILURE;
+		}
+	}
+
+	return ret;
+}
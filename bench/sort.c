@@ -0,0 +1,207 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../aocCommon.h"
+
+/* Compares qsort against the sorts instantiated from aocCommon.h, on plain
+ * ints like the day 1 lists and on pairs of ints like the day 5 rules. The
+ * values are random five digit numbers generated in memory. The length is
+ * given in millions of elements, eg: 100 for the 100M run, which needs about
+ * 2.5 GB. Built as:
+ *
+ * cc -ansi -pedantic -O2 -DAOC_USE_MONOTONIC -D_POSIX_C_SOURCE=200112L \
+ *	bench/sort.c -o aoc-sort */
+#define DEFAULT_MILLIONS (10)
+
+struct intPair
+{
+	int left;
+	int right;
+};
+
+static int compareInts(const void *left, const void *right)
+{
+	const int foo = *(const int *) left;
+	const int bar = *(const int *) right;
+
+	return (foo > bar) - (foo < bar);
+}
+
+static int comparePairs(const void *left, const void *right)
+{
+	const struct intPair * const foo = left;
+	const struct intPair * const bar = right;
+
+	return (foo->left == bar->left)
+		? (foo->right > bar->right) - (foo->right < bar->right)
+		: (foo->left > bar->left) - (foo->left < bar->left);
+}
+
+#define INT_LESS(foo, bar) ((foo) < (bar))
+#define PAIR_LESS(foo, bar)                                     \
+	(((foo).left < (bar).left)                              \
+	|| (((foo).left == (bar).left) && ((foo).right < (bar).right)))
+#define PAIR_LEFT_KEY(pair) AOC_RADIX_INT_KEY((pair).left)
+#define PAIR_RIGHT_KEY(pair) AOC_RADIX_INT_KEY((pair).right)
+
+AOC_DEFINE_RADIX_SORT(radixInts, int, AOC_RADIX_INT_KEY, sizeof(int))
+AOC_DEFINE_INTRO_SORT(introInts, int, INT_LESS)
+AOC_DEFINE_RADIX_SORT(radixPairsByLeft, struct intPair, PAIR_LEFT_KEY,
+	sizeof(int))
+AOC_DEFINE_RADIX_SORT(radixPairsByRight, struct intPair, PAIR_RIGHT_KEY,
+	sizeof(int))
+AOC_DEFINE_INTRO_SORT(introPairs, struct intPair, PAIR_LESS)
+
+static void qsortInts(int *arr, const size_t len)
+{
+	qsort(arr, len, sizeof(int), compareInts);
+}
+
+static void qsortPairs(struct intPair *arr, const size_t len)
+{
+	qsort(arr, len, sizeof(struct intPair), comparePairs);
+}
+
+/* Stability makes sorting on the minor key and then the major one a sort on
+ * the pair */
+static void radixPairs(struct intPair *arr, const size_t len)
+{
+	radixPairsByRight(arr, len);
+	radixPairsByLeft(arr, len);
+}
+
+static unsigned long int nextValue(unsigned long int *seed)
+{
+	*seed = (*seed * 1103515245ul + 12345ul) & 0x7FFFFFFFul;
+
+	return 10000 + (*seed % 90000);
+}
+
+static void runIntBench(const char *name, void (*Sort)(int *, const size_t),
+	const int *input, int *work, const size_t len)
+{
+	double start, secs;
+	AOC_BOOL is_sorted = AOC_TRUE;
+	size_t i;
+
+	memcpy(work, input, sizeof(int) * len);
+	start = clockSeconds();
+	Sort(work, len);
+	secs = clockSeconds() - start;
+
+	for (i = 1; i < len; i++)
+	{
+		if (work[i] < work[i - 1])
+		{
+			is_sorted = AOC_FALSE;
+
+			break;
+		}
+	}
+
+	fprintf(stdout, "%-12s %8.3f s %10.1f M elements/s%s\n", name, secs,
+		(secs > 0.0) ? (len / secs) / 1e6 : 0.0,
+		(is_sorted == AOC_TRUE) ? "" : " (NOT SORTED)");
+}
+
+static void runPairBench(const char *name,
+	void (*Sort)(struct intPair *, const size_t),
+	const struct intPair *input, struct intPair *work, const size_t len)
+{
+	double start, secs;
+	AOC_BOOL is_sorted = AOC_TRUE;
+	size_t i;
+
+	memcpy(work, input, sizeof(struct intPair) * len);
+	start = clockSeconds();
+	Sort(work, len);
+	secs = clockSeconds() - start;
+
+	for (i = 1; i < len; i++)
+	{
+		if (comparePairs(&work[i - 1], &work[i]) > 0)
+		{
+			is_sorted = AOC_FALSE;
+
+			break;
+		}
+	}
+
+	fprintf(stdout, "%-12s %8.3f s %10.1f M elements/s%s\n", name, secs,
+		(secs > 0.0) ? (len / secs) / 1e6 : 0.0,
+		(is_sorted == AOC_TRUE) ? "" : " (NOT SORTED)");
+}
+
+int main(int argc, char **argv)
+{
+	unsigned long int seed = 12345;
+	size_t millions = DEFAULT_MILLIONS;
+	size_t len, i;
+	int *ints = NULL;
+	int *int_work = NULL;
+	struct intPair *pairs = NULL;
+	struct intPair *pair_work = NULL;
+
+	if (argc > 1)
+	{
+		millions = strtoul(argv[1], NULL, 10);
+	}
+
+	if (millions == 0)
+	{
+		fputs("Please provide a length in millions of elements\n",
+			stderr);
+
+		return AOC_FAILURE;
+	}
+
+	len = millions * 1000000;
+
+	/* The ints are done with before the pairs are made so that the two
+	 * runs never hold both sets of buffers at once */
+	if (((ints = malloc(sizeof(int) * len)) == NULL)
+	|| ((int_work = malloc(sizeof(int) * len)) == NULL))
+	{
+		fprintf(stderr, "Unable to allocate %lu M ints\n",
+			(unsigned long int) millions);
+		AOC_FREE(ints);
+
+		return AOC_FAILURE;
+	}
+
+	for (i = 0; i < len; i++)
+	{
+		ints[i] = nextValue(&seed);
+	}
+
+	runIntBench("qsort", qsortInts, ints, int_work, len);
+	runIntBench("introsort", introInts, ints, int_work, len);
+	runIntBench("radix", radixInts, ints, int_work, len);
+	AOC_FREE(ints);
+	AOC_FREE(int_work);
+
+	if (((pairs = malloc(sizeof(struct intPair) * len)) == NULL)
+	|| ((pair_work = malloc(sizeof(struct intPair) * len)) == NULL))
+	{
+		fprintf(stderr, "Unable to allocate %lu M pairs\n",
+			(unsigned long int) millions);
+		AOC_FREE(pairs);
+
+		return AOC_FAILURE;
+	}
+
+	for (i = 0; i < len; i++)
+	{
+		pairs[i].left = nextValue(&seed);
+		pairs[i].right = nextValue(&seed);
+	}
+
+	runPairBench("qsort pairs", qsortPairs, pairs, pair_work, len);
+	runPairBench("intro pairs", introPairs, pairs, pair_work, len);
+	runPairBench("radix pairs", radixPairs, pairs, pair_work, len);
+	AOC_FREE(pairs);
+	AOC_FREE(pair_work);
+
+	return AOC_SUCCESS;
+}
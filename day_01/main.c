@@ -3,7 +3,15 @@
 
 #include "../aocCommon.h"
 
-#define BUFFER_LEN (24)
+/* The vector kernels for the difference score are opt-in with
+ * -DAOC_USE_SIMD and need GCC or Clang on x86-64 with 64 bit longs for their
+ * lanes. They're compiled for their instruction sets with target attributes
+ * and picked at run time so the binary still runs on CPUs without them */
+#if defined(AOC_USE_SIMD) && defined(__GNUC__) && defined(__x86_64__) \
+	&& defined(__LP64__)
+#define HAS_VECTOR_KERNELS
+#include <immintrin.h>
+#endif /* AOC_USE_SIMD */
 
 enum
 {
@@ -12,161 +20,1076 @@ enum
 	NUM_LISTS
 };
 
-static int numCompare(const void *left, const void *right)
+#define INT_LESS(foo, bar) ((foo) < (bar))
+
+AOC_DEFINE_RADIX_SORT(sortList, int, AOC_RADIX_INT_KEY, sizeof(int))
+AOC_DEFINE_LOWER_BOUND(lowerBoundList, int, INT_LESS)
+
+/* Grows both lists to the same new length in one step */
+static void growLists(int **lists, size_t *max)
 {
-	return ((*(int *) left) - (*(int *) right));
+	const size_t new_max = (*max == 0) ? 1024 : (*max * 3) / 2;
+	int *left = AOC_REALLOC(lists[LEFT_LIST], sizeof(int) * new_max);
+	int *right = NULL;
+
+	AOC_ASSERT(left != NULL);
+	lists[LEFT_LIST] = left;
+	right = AOC_REALLOC(lists[RIGHT_LIST], sizeof(int) * new_max);
+	AOC_ASSERT(right != NULL);
+	lists[RIGHT_LIST] = right;
+	*max = new_max;
 }
 
-int** slurpLists(const char *file_path, size_t *list_len)
+/* Reads an optionally negative value that has to fit in an int, returning
+ * where it ended or NULL if there wasn't one. The first nine digits can't
+ * overflow even a 32 bit unsigned long, so unlike scanLong only a tenth
+ * digit needs checking and there's no division per digit. Positions are
+ * passed and returned by value so the loader's loop keeps them in registers
+ * rather than going through a cursor */
+static const char* parseListValue(const char *pos, const char * const end,
+	int *out)
 {
-	FILE *f_handle = NULL;
-	int **ret = NULL;
-	char line_buffer[BUFFER_LEN] = {0};
-	size_t len = 0;
-	size_t max = 10;
+	const unsigned long int limit = (unsigned long int) INT_MAX + 1;
+	const AOC_BOOL negative = (pos < end) && (*pos == '-');
+	const char *digits = pos + negative;
+	const char *stop = digits + AOC_MIN(end - digits, 9);
+	unsigned long int mag = 0;
 
-	if ((f_handle = fopen(file_path, "rb")) == NULL)
+	for (pos = digits; (pos < stop) && (AOC_IS_DIGIT(*pos)); pos++)
 	{
-		return NULL;	
+		mag = (mag * 10) + (*pos - '0');
 	}
 
-	if ((ret = malloc(sizeof(int *) * NUM_LISTS)) == NULL)
+	if ((pos < end) && (AOC_IS_DIGIT(*pos)))
 	{
-		fclose(f_handle);
+		if (mag > limit / 10)
+		{
+			return NULL;
+		}
+
+		mag = (mag * 10) + (*pos - '0');
+		pos++;
+	}
+
+	if ((pos == digits) || ((pos < end) && (AOC_IS_DIGIT(*pos)))
+	|| (mag > limit - (negative == AOC_FALSE)))
+	{
+		return NULL;
+	}
+
+	*out = (negative == AOC_TRUE) 
+		? (mag == limit) ? INT_MIN : -(int) mag 
+		: (int) mag;
+
+	return pos;
+}
+
+/* Only spaces and tabs separate the two values on a line */
+#define IS_BLANK(ch) (((ch) == ' ') || ((ch) == '\t'))
+#define IS_SPACE(ch) (IS_BLANK(ch) || ((ch) == '\r') || ((ch) == '\n'))
+
+/* Reads the two values of the line at 'pos', which has to hold exactly two
+ * values that fit in an int, returning where the line ends or NULL if it's
+ * malformed */
+static const char* parseListLine(const char *pos, const char * const end,
+	int *left, int *right)
+{
+	if ((pos = parseListValue(pos, end, left)) == NULL)
+	{
+		return NULL;
+	}
+
+	while ((pos < end) && (IS_BLANK(*pos)))
+	{
+		pos++;
+	}
 
+	if ((pos = parseListValue(pos, end, right)) == NULL)
+	{
 		return NULL;
 	}
 
-	AOC_NEW_DYN_ARR(int, ret[LEFT_LIST], max);
-	AOC_NEW_DYN_ARR(int, ret[RIGHT_LIST], max);
+	while ((pos < end) && (IS_BLANK(*pos)))
+	{
+		pos++;
+	}
 
-	while (fgets(line_buffer, BUFFER_LEN, f_handle) != NULL)
+	return ((pos < end) && (*pos != '\r') && (*pos != '\n')) ? NULL : pos;
+}
+
+/* Blank lines, and the line endings after each line, are skipped */
+static const char* skipListSpace(const char *pos, const char * const end)
+{
+	while ((pos < end) && (IS_SPACE(*pos)))
+	{
+		pos++;
+	}
+
+	return pos;
+}
+
+/* Large inputs are cut at line boundaries into a chunk per worker, and each
+ * worker parses and sorts its own chunk. The sorted chunks are then merged
+ * back into the two lists, split into several slices per chunk by pivot
+ * values so that the merge is spread across the workers as well. Inputs
+ * smaller than two chunks, and builds without AOC_USE_THREADS, are loaded
+ * as a single chunk on the calling thread with nothing to merge */
+#define MIN_CHUNK_LEN    ((size_t) 1 << 20)
+#define MAX_CHUNKS       (64)
+#define SLICES_PER_CHUNK (4)
+#define MAX_SLICES       (MAX_CHUNKS * SLICES_PER_CHUNK)
+
+/* Values from 0 up to this, which covers the puzzle's five digit ones, can
+ * instead be counted into a histogram per list. Inputs with at least as many
+ * lines as there are buckets are counted that way first, so their memory
+ * doesn't grow with the line count, and go back to being stored and sorted
+ * only if a value turns out to be out of range */
+#define HISTOGRAM_LEN ((size_t) 1 << 17)
+
+struct listChunk
+{
+	size_t begin;
+	size_t end;
+	int *vals[NUM_LISTS];
+	size_t *counts[NUM_LISTS];
+	size_t len;
+	AOC_STAT status;
+};
+
+/* Both columns of a chunk are read in a single pass, rather than splitting
+ * it into lines first, straight into lists sized from the estimated line
+ * count */
+static AOC_STAT parseChunk(const struct aocView *input, 
+	struct listChunk *chunk)
+{
+	const char *pos = input->data + chunk->begin;
+	const char * const end = input->data + chunk->end;
+	size_t len = 0;
+	size_t max;
+
+	max = AOC_MAX(viewEstimateLines(input, chunk->begin, chunk->end), 1);
+	AOC_NEW_DYN_ARR(int, chunk->vals[LEFT_LIST], max);
+	AOC_NEW_DYN_ARR(int, chunk->vals[RIGHT_LIST], max);
+
+	while ((pos = skipListSpace(pos, end)) < end)
 	{
 		int left, right;
 
-		if (sscanf(line_buffer, "%d %d", &left, &right) != 2)
+		if ((pos = parseListLine(pos, end, &left, &right)) == NULL)
 		{
-			AOC_FREE(ret[LEFT_LIST]);
-			AOC_FREE(ret[RIGHT_LIST]);
-			AOC_FREE(ret);
-			fclose(f_handle);
-
-			return NULL;
+			return AOC_FAILURE;
 		}
 
 		if (len == max)
 		{
-			/* AOC_GROW_DYN_ARR modifies max so a temporary
-			 * variable is needed to resize both to the same 
-			 * length */
-			size_t tmp_max = max;
+			growLists(chunk->vals, &max);
+		}
 
-			AOC_GROW_DYN_ARR(int, ret[LEFT_LIST], max);
-			AOC_GROW_DYN_ARR(int, ret[RIGHT_LIST], tmp_max);
+		chunk->vals[LEFT_LIST][len] = left;
+		chunk->vals[RIGHT_LIST][len] = right;
+		len++;
+	}
+
+	chunk->len = len;
+	sortList(chunk->vals[LEFT_LIST], len);
+	sortList(chunk->vals[RIGHT_LIST], len);
+
+	return AOC_SUCCESS;
+}
+
+/* The same pass as parseChunk but into histograms, failing on a value
+ * outside of them as well as on a malformed line */
+static AOC_STAT countChunk(const struct aocView *input, 
+	struct listChunk *chunk)
+{
+	const char *pos = input->data + chunk->begin;
+	const char * const end = input->data + chunk->end;
+	size_t *left_counts = NULL;
+	size_t *right_counts = NULL;
+	size_t len = 0;
+
+	AOC_NEW_DYN_ARR(size_t, chunk->counts[LEFT_LIST], HISTOGRAM_LEN);
+	AOC_NEW_DYN_ARR(size_t, chunk->counts[RIGHT_LIST], HISTOGRAM_LEN);
+	left_counts = chunk->counts[LEFT_LIST];
+	right_counts = chunk->counts[RIGHT_LIST];
+	memset(left_counts, 0, sizeof(size_t) * HISTOGRAM_LEN);
+	memset(right_counts, 0, sizeof(size_t) * HISTOGRAM_LEN);
+
+	while ((pos = skipListSpace(pos, end)) < end)
+	{
+		int left, right;
+
+		if (((pos = parseListLine(pos, end, &left, &right)) == NULL)
+		|| (left < 0) || ((size_t) left >= HISTOGRAM_LEN)
+		|| (right < 0) || ((size_t) right >= HISTOGRAM_LEN))
+		{
+			return AOC_FAILURE;
 		}
 
-		ret[LEFT_LIST][len] = left;
-		ret[RIGHT_LIST][len] = right;
+		left_counts[left]++;
+		right_counts[right]++;
 		len++;
 	}
 
-	*list_len = len;
-	fclose(f_handle);
-	qsort(ret[LEFT_LIST], len, sizeof(int), numCompare);
-	qsort(ret[RIGHT_LIST], len, sizeof(int), numCompare);
+	chunk->len = len;
 
-	return ret;
+	return AOC_SUCCESS;
 }
 
-static int differenceScore(int **lists, const size_t len)
+/* Everything the workers share while loading the lists */
+struct listLoad
+{
+	const struct aocView *input;
+	struct listChunk chunks[MAX_CHUNKS];
+	size_t num_chunks;
+	int pivots[NUM_LISTS][MAX_SLICES];
+	size_t num_slices;
+	int *merged[NUM_LISTS];
+	AOC_STAT (*Load)(const struct aocView *input, 
+		struct listChunk *chunk);
+};
+
+/* Each chunk ends just after the first newline at or past an even share of
+ * the input, the last one at the end of it */
+static void splitChunks(struct listLoad *load)
 {
+	const size_t len = load->input->len;
+	const size_t share = len / load->num_chunks;
+	size_t begin = 0;
 	size_t i;
-	int diff = 0;
 
-	for (i = 0; i < len; i++)
+	for (i = 0; i < load->num_chunks; i++)
+	{
+		struct listChunk *chunk = &load->chunks[i];
+		size_t end = len;
+
+		if (i + 1 < load->num_chunks)
+		{
+			const char *newline = NULL;
+
+			end = AOC_MAX(share * (i + 1), begin);
+			newline = memchr(load->input->data + end, '\n', 
+				len - end);
+			end = (newline == NULL) 
+				? len 
+				: (size_t) (newline - load->input->data) + 1;
+		}
+
+		chunk->begin = begin;
+		chunk->end = end;
+		chunk->vals[LEFT_LIST] = NULL;
+		chunk->vals[RIGHT_LIST] = NULL;
+		chunk->counts[LEFT_LIST] = NULL;
+		chunk->counts[RIGHT_LIST] = NULL;
+		chunk->len = 0;
+		chunk->status = AOC_FAILURE;
+		begin = end;
+	}
+}
+
+static void parseChunksBody(void *ctx, size_t begin, size_t end, 
+	size_t slot)
+{
+	struct listLoad *load = ctx;
+
+	(void) slot;
+
+	for (; begin < end; begin++)
+	{
+		load->chunks[begin].status = load->Load(load->input, 
+			&load->chunks[begin]);
+	}
+}
+
+/* Restores the min heap of chunk heads below 'node' */
+static void siftDownHeads(size_t *heap, const size_t len, size_t node,
+	const int * const *heads)
+{
+	for (;;)
+	{
+		const size_t child = (node * 2) + 1;
+		size_t least = node;
+		size_t tmp;
+
+		if ((child < len) 
+		&& (*heads[heap[child]] < *heads[heap[least]]))
+		{
+			least = child;
+		}
+
+		if ((child + 1 < len) 
+		&& (*heads[heap[child + 1]] < *heads[heap[least]]))
+		{
+			least = child + 1;
+		}
+
+		if (least == node)
+		{
+			return;
+		}
+
+		tmp = heap[node];
+		heap[node] = heap[least];
+		heap[least] = tmp;
+		node = least;
+	}
+}
+
+/* A slice holds the values from one pivot up to the next in every chunk, so
+ * where it starts in the merged list is the sum of where it starts in each
+ * chunk. Its runs are merged through a min heap of the chunks' heads */
+static void mergeSlice(struct listLoad *load, const size_t list, 
+	const size_t slice)
+{
+	const int *heads[MAX_CHUNKS];
+	const int *stops[MAX_CHUNKS];
+	size_t heap[MAX_CHUNKS];
+	size_t num_heap = 0;
+	size_t offset = 0;
+	int *out = NULL;
+	size_t i;
+
+	for (i = 0; i < load->num_chunks; i++)
+	{
+		const int *vals = load->chunks[i].vals[list];
+		const size_t len = load->chunks[i].len;
+		const size_t begin = (slice == 0) 
+			? 0 
+			: lowerBoundList(vals, len, 
+				load->pivots[list][slice - 1]);
+		const size_t end = (slice + 1 == load->num_slices) 
+			? len 
+			: lowerBoundList(vals, len, 
+				load->pivots[list][slice]);
+
+		offset += begin;
+		heads[i] = vals + begin;
+		stops[i] = vals + end;
+
+		if (begin < end)
+		{
+			heap[num_heap++] = i;
+		}
+	}
+
+	for (i = num_heap / 2; i > 0; i--)
 	{
-		diff += (AOC_ABS(lists[LEFT_LIST][i] - lists[RIGHT_LIST][i]));
+		siftDownHeads(heap, num_heap, i - 1, heads);
 	}
 
-	return diff;
+	out = load->merged[list] + offset;
+
+	while (num_heap > 0)
+	{
+		const size_t least = heap[0];
+
+		*out++ = *heads[least]++;
+
+		if (heads[least] == stops[least])
+		{
+			heap[0] = heap[--num_heap];
+		}
+
+		siftDownHeads(heap, num_heap, 0, heads);
+	}
+}
+
+/* Indices cover the slices of the left list and then those of the right */
+static void mergeSlicesBody(void *ctx, size_t begin, size_t end, 
+	size_t slot)
+{
+	struct listLoad *load = ctx;
+
+	(void) slot;
+
+	for (; begin < end; begin++)
+	{
+		mergeSlice(load, begin / load->num_slices, 
+			begin % load->num_slices);
+	}
 }
 
-static int getRightCount(int *right_list, const int target, const size_t len)
+/* Lists that were counted rather than stored have histograms in place of
+ * their sorted values */
+struct dayLists
 {
-	int count = 0;
-	size_t found = leftBinSearch(right_list, len, &target, sizeof(int),
-		numCompare);
+	int *vals[NUM_LISTS];
+	size_t *counts[NUM_LISTS];
+	size_t len;
+	size_t num_threads; /* 1 when there's only the calling thread */
+};
 
-	while ((found < len) 
-	&& (right_list[found] == target))
+/* Calls Body over [0, len) on the pool, or straight from this thread when
+ * there isn't one */
+static AOC_STAT runLists(struct aocPool *pool, const size_t len, 
+	const size_t grain,
+	void (*Body)(void *ctx, size_t begin, size_t end, size_t slot),
+	void *ctx)
+{
+	if (pool == NULL)
 	{
-		count++;
-		found++;
+		Body(ctx, 0, len, 0);
+
+		return AOC_SUCCESS;
 	}
 
-	return count;	
+	return poolParallelFor(pool, 0, len, grain, Body, ctx);
 }
 
-static int similarityScore(int **lists, const size_t len)
+/* The pivots of each list are taken at even steps through the largest
+ * chunk, which as the chunks are cut from the same input should split the
+ * others about evenly too */
+static void pickPivots(struct listLoad *load)
 {
-	size_t i = 0;
-	int running = 0;
-	int count = 0;
-	int current;
+	const struct listChunk *largest = &load->chunks[0];
+	size_t list, i;
 
-	if (len == 0)
+	for (i = 1; i < load->num_chunks; i++)
 	{
-		return -1;
+		if (load->chunks[i].len > largest->len)
+		{
+			largest = &load->chunks[i];
+		}
 	}
 
-	do
+	for (list = 0; list < NUM_LISTS; list++)
 	{
-		current = lists[LEFT_LIST][i];
-		count = getRightCount(lists[RIGHT_LIST], current, len);
+		for (i = 1; i < load->num_slices; i++)
+		{
+			load->pivots[list][i - 1] = largest->vals[list][
+				(largest->len / load->num_slices) * i];
+		}
+	}
+}
 
-		while ((i < len) 
-		&& (current == lists[LEFT_LIST][i]))
+/* Cuts the input into chunks and reads each with Load across the pool,
+ * leaving them for the caller to combine */
+static AOC_STAT loadChunks(struct listLoad *load, struct aocPool *pool,
+	size_t *len)
+{
+	AOC_STAT ret;
+	size_t i;
+
+	splitChunks(load);
+
+	AOC_TRACE_BEGIN("parse chunks");
+	ret = runLists(pool, load->num_chunks, 1, parseChunksBody, load);
+	AOC_TRACE_END("parse chunks");
+
+	*len = 0;
+
+	for (i = 0; i < load->num_chunks; i++)
+	{
+		if (load->chunks[i].status != AOC_SUCCESS)
 		{
-			running += (current * count);	
-			i++;
+			ret = AOC_FAILURE;
 		}
-	} while (i < len);
 
-	return running;
+		*len += load->chunks[i].len;
+	}
+
+	return ret;
 }
 
-int main(int argc, char **argv)
+static struct listLoad* newLoad(const struct aocView *input, 
+	const size_t num_chunks,
+	AOC_STAT (*Load)(const struct aocView *, struct listChunk *))
 {
-	size_t i, len;
+	struct listLoad *load = NULL;
 
-	if (argc < 2)
+	if ((load = malloc(sizeof(struct listLoad))) == NULL)
 	{
-		fprintf(stderr, "Please provide an input file\n");
+		return NULL;
+	}
+
+	load->input = input;
+	load->num_chunks = num_chunks;
+	load->num_slices = num_chunks * SLICES_PER_CHUNK;
+	load->Load = Load;
+
+	return load;
+}
+
+static void freeLoad(struct listLoad *load)
+{
+	size_t i, list;
+
+	for (i = 0; i < load->num_chunks; i++)
+	{
+		for (list = 0; list < NUM_LISTS; list++)
+		{
+			AOC_FREE(load->chunks[i].vals[list]);
+			AOC_FREE(load->chunks[i].counts[list]);
+		}
+	}
+
+	AOC_FREE(load);
+}
+
+static AOC_STAT loadLists(const struct aocView *input, 
+	struct dayLists *lists, struct aocPool *pool, const size_t num_chunks)
+{
+	struct listLoad *load = NULL;
+	AOC_STAT ret = AOC_SUCCESS;
+	size_t list;
+
+	if ((load = newLoad(input, num_chunks, parseChunk)) == NULL)
+	{
+		return AOC_FAILURE;
+	}
+
+	if (loadChunks(load, pool, &lists->len) != AOC_SUCCESS)
+	{
+		freeLoad(load);
 
 		return AOC_FAILURE;
 	}
 
-	for (i = 1; i < argc; i++)
+	/* A single chunk's lists are already the sorted lists */
+	if (num_chunks == 1)
+	{
+		for (list = 0; list < NUM_LISTS; list++)
+		{
+			lists->vals[list] = load->chunks[0].vals[list];
+			load->chunks[0].vals[list] = NULL;
+		}
+
+		freeLoad(load);
+
+		return AOC_SUCCESS;
+	}
+
+	for (list = 0; list < NUM_LISTS; list++)
+	{
+		AOC_NEW_DYN_ARR(int, load->merged[list], 
+			AOC_MAX(lists->len, 1));
+		lists->vals[list] = load->merged[list];
+	}
+
+	if (lists->len > 0)
+	{
+		pickPivots(load);
+		AOC_TRACE_BEGIN("merge");
+		ret = runLists(pool, NUM_LISTS * load->num_slices, 1, 
+			mergeSlicesBody, load);
+		AOC_TRACE_END("merge");
+	}
+
+	freeLoad(load);
+
+	return ret;
+}
+
+/* The chunks' histograms are added into the first one's, which the lists
+ * then keep. Nothing is kept when any chunk failed */
+static AOC_STAT loadHistograms(const struct aocView *input, 
+	struct dayLists *lists, struct aocPool *pool, const size_t num_chunks)
+{
+	struct listLoad *load = NULL;
+	size_t i, list, val;
+
+	if ((load = newLoad(input, num_chunks, countChunk)) == NULL)
+	{
+		return AOC_FAILURE;
+	}
+
+	if (loadChunks(load, pool, &lists->len) != AOC_SUCCESS)
+	{
+		freeLoad(load);
+
+		return AOC_FAILURE;
+	}
+
+	for (list = 0; list < NUM_LISTS; list++)
+	{
+		size_t * const counts = load->chunks[0].counts[list];
+
+		for (i = 1; i < num_chunks; i++)
+		{
+			const size_t * const other 
+				= load->chunks[i].counts[list];
+
+			for (val = 0; val < HISTOGRAM_LEN; val++)
+			{
+				counts[val] += other[val];
+			}
+		}
+
+		lists->counts[list] = counts;
+		load->chunks[0].counts[list] = NULL;
+	}
+
+	freeLoad(load);
+
+	return AOC_SUCCESS;
+}
+
+/* Taking the smaller value from the larger as unsigned ints gives the exact
+ * difference of any two ints, even one that overflows an int. Written as a
+ * max and a min it compiles to conditional moves rather than a branch */
+#define ABS_DIFF(foo, bar)                          \
+	((unsigned int) AOC_MAX((foo), (bar))       \
+	- (unsigned int) AOC_MIN((foo), (bar)))
+
+/* Blocks are summed without checks and then added to the score with one, a
+ * block of up to 2^30 differences can't overflow a 64 bit lane or AOC_ACC */
+#define DIFF_BLOCK_LEN ((size_t) 1 << 30)
+
+typedef AOC_ACC (*diffKernel)(const int *, const int *, const size_t);
+
+static AOC_ACC sumDiffScalar(const int *left, const int *right,
+	const size_t len)
+{
+	AOC_ACC sum = 0;
+	size_t i;
+
+	for (i = 0; i < len; i++)
+	{
+		sum += ABS_DIFF(left[i], right[i]);
+	}
+
+	return sum;
+}
+
+#if defined(HAS_VECTOR_KERNELS)
+/* Max minus min is the unsigned difference of each pair of lanes, which are
+ * then interleaved with zeroes to widen them into 64 bit sums */
+__attribute__((target("avx2")))
+static AOC_ACC sumDiffAvx2(const int *left, const int *right,
+	const size_t len)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	__m256i sums = zero;
+	unsigned long int lanes[4];
+	size_t i;
+
+	for (i = 0; i + 8 <= len; i += 8)
+	{
+		const __m256i foo = _mm256_loadu_si256(
+			(const __m256i *) (left + i));
+		const __m256i bar = _mm256_loadu_si256(
+			(const __m256i *) (right + i));
+		const __m256i diff = _mm256_sub_epi32(
+			_mm256_max_epi32(foo, bar), _mm256_min_epi32(foo, bar));
+
+		sums = _mm256_add_epi64(sums,
+			_mm256_unpacklo_epi32(diff, zero));
+		sums = _mm256_add_epi64(sums,
+			_mm256_unpackhi_epi32(diff, zero));
+	}
+
+	_mm256_storeu_si256((__m256i *) lanes, sums);
+
+	return (AOC_ACC) (lanes[0] + lanes[1] + lanes[2] + lanes[3])
+		+ sumDiffScalar(left + i, right + i, len - i);
+}
+
+__attribute__((target("sse4.1")))
+static AOC_ACC sumDiffSse41(const int *left, const int *right,
+	const size_t len)
+{
+	const __m128i zero = _mm_setzero_si128();
+	__m128i sums = zero;
+	unsigned long int lanes[2];
+	size_t i;
+
+	for (i = 0; i + 4 <= len; i += 4)
 	{
-		int **vals = NULL;
+		const __m128i foo = _mm_loadu_si128(
+			(const __m128i *) (left + i));
+		const __m128i bar = _mm_loadu_si128(
+			(const __m128i *) (right + i));
+		const __m128i diff = _mm_sub_epi32(_mm_max_epi32(foo, bar),
+			_mm_min_epi32(foo, bar));
+
+		sums = _mm_add_epi64(sums, _mm_unpacklo_epi32(diff, zero));
+		sums = _mm_add_epi64(sums, _mm_unpackhi_epi32(diff, zero));
+	}
+
+	_mm_storeu_si128((__m128i *) lanes, sums);
+
+	return (AOC_ACC) (lanes[0] + lanes[1])
+		+ sumDiffScalar(left + i, right + i, len - i);
+}
+#endif /* HAS_VECTOR_KERNELS */
+
+static diffKernel selectDiffKernel(void)
+{
+#if defined(HAS_VECTOR_KERNELS)
+	if (__builtin_cpu_supports("avx2"))
+	{
+		return sumDiffAvx2;
+	}
+
+	if (__builtin_cpu_supports("sse4.1"))
+	{
+		return sumDiffSse41;
+	}
+#endif /* HAS_VECTOR_KERNELS */
+
+	return sumDiffScalar;
+}
 
-		if ((vals = slurpLists(argv[i], &len)) == NULL)
+/* Pairing the nth smallest values of the lists is walking both histograms
+ * in step, each step pairs off as many values as the current buckets of
+ * both lists still hold */
+static AOC_STAT histogramDifference(const struct dayLists *lists, 
+	AOC_ACC *score)
+{
+	const size_t * const left = lists->counts[LEFT_LIST];
+	const size_t * const right = lists->counts[RIGHT_LIST];
+	size_t left_val = 0;
+	size_t right_val = 0;
+	size_t left_rem = left[0];
+	size_t right_rem = right[0];
+	AOC_ACC diff = 0;
+
+	for (;;)
+	{
+		size_t pairs;
+		AOC_ACC step;
+
+		while ((left_rem == 0) && (++left_val < HISTOGRAM_LEN))
 		{
-			fprintf(stderr, "Failed to slurp inputs\n");
+			left_rem = left[left_val];
+		}
 
+		while ((right_rem == 0) && (++right_val < HISTOGRAM_LEN))
+		{
+			right_rem = right[right_val];
+		}
+
+		/* Both lists hold as many values so they run out together */
+		if ((left_val == HISTOGRAM_LEN) || (right_val == HISTOGRAM_LEN))
+		{
+			break;
+		}
+
+		pairs = AOC_MIN(left_rem, right_rem);
+		step = (left_val > right_val) 
+			? left_val - right_val 
+			: right_val - left_val;
+
+		if ((accMul(&step, (AOC_ACC) pairs) != AOC_SUCCESS)
+		|| (accAdd(&diff, step) != AOC_SUCCESS))
+		{
 			return AOC_FAILURE;
 		}
 
-		fprintf(stdout, "Cumulative difference: %u\n", 
-			differenceScore(vals, len));
-		fprintf(stdout, "Similarity score: %u\n",
-			similarityScore(vals, len));
+		left_rem -= pairs;
+		right_rem -= pairs;
+	}
+
+	*score = diff;
+
+	return AOC_SUCCESS;
+}
+
+static AOC_STAT histogramSimilarity(const struct dayLists *lists, 
+	AOC_ACC *score)
+{
+	const size_t * const left = lists->counts[LEFT_LIST];
+	const size_t * const right = lists->counts[RIGHT_LIST];
+	AOC_ACC running = 0;
+	size_t val;
+
+	for (val = 0; val < HISTOGRAM_LEN; val++)
+	{
+		AOC_ACC product = val;
+
+		if ((left[val] == 0) || (right[val] == 0))
+		{
+			continue;
+		}
 
-		AOC_FREE(vals[LEFT_LIST]);
-		AOC_FREE(vals[RIGHT_LIST]);
-		AOC_FREE(vals);
+		if ((accMul(&product, (AOC_ACC) left[val]) != AOC_SUCCESS)
+		|| (accMul(&product, (AOC_ACC) right[val]) != AOC_SUCCESS)
+		|| (accAdd(&running, product) != AOC_SUCCESS))
+		{
+			return AOC_FAILURE;
+		}
 	}
 
+	*score = running;
+
 	return AOC_SUCCESS;
 }
 
+/* Both parts are reductions over the lists. The range is split across the
+ * workers and each sums into its own slot, which are only added together
+ * once every worker is done. A slot that overflows marks its status. The
+ * workers only live as long as the reduction so none sit idle between the
+ * parts */
+struct listReduction
+{
+	const struct dayLists *lists;
+	diffKernel Kernel;
+	size_t block_len;
+	union aocPoolSum *sums;
+	AOC_STAT *status;
+};
+
+static AOC_STAT reduceLists(struct listReduction *reduce,
+	void (*Body)(void *ctx, size_t begin, size_t end, size_t slot),
+	AOC_ACC *score)
+{
+	const struct dayLists *lists = reduce->lists;
+	const size_t num_slots = lists->num_threads;
+	struct aocPool *pool = NULL;
+	AOC_STAT ret = AOC_SUCCESS;
+	AOC_ACC total = 0;
+	size_t i;
+
+	reduce->sums = NULL;
+	reduce->status = NULL;
+
+	if (((num_slots > 1) && ((pool = poolCreate(num_slots)) == NULL))
+	|| ((reduce->sums = calloc(num_slots, sizeof(union aocPoolSum))) 
+		== NULL)
+	|| ((reduce->status = malloc(sizeof(AOC_STAT) * num_slots)) == NULL))
+	{
+		poolDestroy(pool);
+		AOC_FREE(reduce->sums);
+
+		return AOC_FAILURE;
+	}
+
+	for (i = 0; i < num_slots; i++)
+	{
+		reduce->status[i] = AOC_SUCCESS;
+	}
+
+	ret = runLists(pool, lists->len, 0, Body, reduce);
+	poolDestroy(pool);
+
+	for (i = 0; (ret == AOC_SUCCESS) && (i < num_slots); i++)
+	{
+		if ((reduce->status[i] != AOC_SUCCESS)
+		|| (accAdd(&total, reduce->sums[i].sum) != AOC_SUCCESS))
+		{
+			ret = AOC_FAILURE;
+		}
+	}
+
+	AOC_FREE(reduce->sums);
+	AOC_FREE(reduce->status);
+	*score = total;
+
+	return ret;
+}
+
+static void differenceBody(void *ctx, size_t begin, size_t end, 
+	size_t slot)
+{
+	struct listReduction *reduce = ctx;
+	const int * const left = reduce->lists->vals[LEFT_LIST];
+	const int * const right = reduce->lists->vals[RIGHT_LIST];
+
+	for (; begin < end; begin += reduce->block_len)
+	{
+		const AOC_ACC block = reduce->Kernel(left + begin, 
+			right + begin, AOC_MIN(reduce->block_len, end - begin));
+
+		if ((block < 0) 
+		|| (accAdd(&reduce->sums[slot].sum, block) != AOC_SUCCESS))
+		{
+			reduce->status[slot] = AOC_FAILURE;
+
+			return;
+		}
+	}
+}
+
+/* Where AOC_ACC is too narrow for whole blocks, eg: a 32 bit long, every
+ * difference is its own block and one too large for AOC_ACC comes back
+ * negative */
+static AOC_STAT differenceScore(const struct dayLists *lists, 
+	AOC_ACC *score)
+{
+	struct listReduction reduce;
+	const AOC_BOOL is_blocked = (AOC_ACC_MAX / UINT_MAX) 
+		>= (AOC_ACC) DIFF_BLOCK_LEN;
+
+	if (lists->counts[LEFT_LIST] != NULL)
+	{
+		return histogramDifference(lists, score);
+	}
+
+	reduce.lists = lists;
+	reduce.Kernel = (is_blocked == AOC_TRUE) 
+		? selectDiffKernel() : sumDiffScalar;
+	reduce.block_len = (is_blocked == AOC_TRUE) ? DIFF_BLOCK_LEN : 1;
+
+	return reduceLists(&reduce, differenceBody, score);
+}
+
+/* Both lists are sorted so one pass over each pairs up the runs of equal
+ * values, each run on the left scores its value times its own length times
+ * the length of the matching run on the right. That's linear in the lists
+ * where searching the right list for every distinct left value wasn't. A
+ * range only has to search once for where its first value starts on the
+ * right, a run cut in two by the ranges is simply scored in two parts */
+static void similarityBody(void *ctx, size_t begin, size_t end, 
+	size_t slot)
+{
+	struct listReduction *reduce = ctx;
+	const int * const left = reduce->lists->vals[LEFT_LIST];
+	const int * const right = reduce->lists->vals[RIGHT_LIST];
+	const size_t len = reduce->lists->len;
+	size_t j = lowerBoundList(right, len, left[begin]);
+
+	while (begin < end)
+	{
+		const int current = left[begin];
+		const size_t left_start = begin;
+		size_t right_start;
+		AOC_ACC product = current;
+
+		while ((begin < end) && (left[begin] == current))
+		{
+			begin++;
+		}
+
+		while ((j < len) && (right[j] < current))
+		{
+			j++;
+		}
+
+		right_start = j;
+
+		while ((j < len) && (right[j] == current))
+		{
+			j++;
+		}
+
+		if (j == right_start)
+		{
+			continue;
+		}
+
+		if ((accMul(&product, (AOC_ACC) (begin - left_start)) 
+			!= AOC_SUCCESS)
+		|| (accMul(&product, (AOC_ACC) (j - right_start)) 
+			!= AOC_SUCCESS)
+		|| (accAdd(&reduce->sums[slot].sum, product) != AOC_SUCCESS))
+		{
+			reduce->status[slot] = AOC_FAILURE;
+
+			return;
+		}
+	}
+}
+
+static AOC_STAT similarityScore(const struct dayLists *lists, 
+	AOC_ACC *score)
+{
+	struct listReduction reduce;
+
+	/* The sum over no pairs, this also keeps similarityBody from looking
+	 * up the first value of an empty list */
+	if (lists->len == 0)
+	{
+		*score = 0;
+
+		return AOC_SUCCESS;
+	}
+
+	if (lists->counts[LEFT_LIST] != NULL)
+	{
+		return histogramSimilarity(lists, score);
+	}
+
+	reduce.lists = lists;
+	reduce.Kernel = sumDiffScalar;
+	reduce.block_len = 0;
+
+	return reduceLists(&reduce, similarityBody, score);
+}
+
+static void dayFree(void *ctx)
+{
+	struct dayLists *lists = ctx;
+
+	if (lists != NULL)
+	{
+		AOC_FREE(lists->vals[LEFT_LIST]);
+		AOC_FREE(lists->vals[RIGHT_LIST]);
+		AOC_FREE(lists->counts[LEFT_LIST]);
+		AOC_FREE(lists->counts[RIGHT_LIST]);
+		AOC_FREE(lists);
+	}
+}
+
+/* Each worker of the pool takes a chunk of the input, see MIN_CHUNK_LEN,
+ * and inputs long enough are counted rather than stored where they can be,
+ * see HISTOGRAM_LEN. The workers are no more than the input was granted and
+ * the pool is gone once the input is loaded, the parts start their own */
+static void* dayParse(const struct aocView *input)
+{
+	struct dayLists *ctx = NULL;
+	struct aocPool *pool = NULL;
+	const size_t num_chunks = AOC_MIN(AOC_MIN(AOC_MIN(input->num_threads,
+		poolDefaultThreads()), MAX_CHUNKS),
+		AOC_MAX(input->len / MIN_CHUNK_LEN, 1));
+	AOC_STAT ret;
+
+	if ((ctx = malloc(sizeof(struct dayLists))) == NULL)
+	{
+		return NULL;
+	}
+
+	ctx->vals[LEFT_LIST] = NULL;
+	ctx->vals[RIGHT_LIST] = NULL;
+	ctx->counts[LEFT_LIST] = NULL;
+	ctx->counts[RIGHT_LIST] = NULL;
+	ctx->num_threads = AOC_MAX(num_chunks, 1);
+
+	if ((num_chunks > 1) && ((pool = poolCreate(num_chunks)) == NULL))
+	{
+		dayFree(ctx);
+
+		return NULL;
+	}
+
+	if ((viewEstimateLines(input, 0, input->len) < HISTOGRAM_LEN)
+	|| ((ret = loadHistograms(input, ctx, pool, num_chunks)) 
+		!= AOC_SUCCESS))
+	{
+		ret = loadLists(input, ctx, pool, num_chunks);
+	}
+
+	poolDestroy(pool);
+
+	if (ret != AOC_SUCCESS)
+	{
+		dayFree(ctx);
+
+		return NULL;
+	}
+
+	return ctx;
+}
+
+static AOC_STAT dayPart1(void *ctx, AOC_ACC *answer)
+{
+	return differenceScore(ctx, answer);
+}
+
+static AOC_STAT dayPart2(void *ctx, AOC_ACC *answer)
+{
+	return similarityScore(ctx, answer);
+}
+
+const struct aocDay aoc_day_01 =
+{
+	1, dayParse, dayPart1, dayPart2, dayFree,
+	"Cumulative difference: %s\n",
+	"Similarity score: %s\n"
+};
+
+#ifndef AOC_NO_MAIN
+int main(int argc, char **argv)
+{
+	return runDayMain(&aoc_day_01, argc, argv);
+}
+#endif /* AOC_NO_MAIN */
@@ -1,23 +1,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <errno.h>
 
 #include "../aocCommon.h"
 
-#define BUFFER_LEN (128)
-
-static long int extractValue(const char * const str)
-{
-	long int ret;
-
-	errno = 0;
-	ret = strtol(str, NULL, 0);
-	AOC_ASSERT(errno == 0);
-
-	return ret;
-}
-
 static AOC_BOOL isSafe(const int dir, const long int last, const long int curr)
 {
 	const long int diff = AOC_ABS(curr - last);
@@ -35,111 +21,156 @@ static AOC_BOOL isSafe(const int dir, const long int last, const long int curr)
 	}
 }
 
-/* In a real application it would be better to write a threadsafe tokenizer */
-static int parseLevels(FILE *input, const AOC_BOOL use_dampener)
+/* The direction is set by the report's first two levels. With the dampener
+ * the first level that breaks the rules is dropped, once, and checking goes
+ * on from the level before it */
+static AOC_BOOL isReportSafe(const long int *levels, const size_t len, 
+	AOC_BOOL dampener)
 {
-	char line_buffer[BUFFER_LEN] = {0};
-	int num_safe = 0;
+	long int last, curr;
+	int direction;
+	size_t i;
 
-	while (fgets(line_buffer, BUFFER_LEN, input) != NULL)
+	/* A report with only one value isn't well defined by the problem but
+	 * here is assumed to be safe */
+	if (len < 2)
 	{
-		long int last, curr;
-		int direction = 0;
-		char *token = NULL;
-		AOC_BOOL early_exit = AOC_FALSE;
-		AOC_BOOL dampener = use_dampener;
-
-		/* First prime last, curr, and direction using the first 
-		 * two values of the report */
-		last = extractValue(strtok(line_buffer, " "));
-
-		/* List contains only one value which isn't well defined by
-		 * the problem but here is assumed to be safe */
-		if ((token = strtok(NULL, " ")) == NULL)
-		{
-			num_safe++;
-
-			continue;
-		}
+		return AOC_TRUE;
+	}
 
-		curr = extractValue(token);
-		direction = curr - last;
+	last = levels[0];
+	curr = levels[1];
+	direction = (curr > last) - (curr < last);
 
-		/* XXX: If curr value is invalidated by the dampener
-		 * there is the possibilty of the direction needing to change.
-		 * But the problem doesn't specify what the behavior for this
-		 * situation should be and it does not show up in the input */
+	/* XXX: If curr value is invalidated by the dampener
+	 * there is the possibilty of the direction needing to change.
+	 * But the problem doesn't specify what the behavior for this
+	 * situation should be and it does not show up in the input */
+	for (i = 2; ; i++)
+	{
 		if (isSafe(direction, last, curr) == AOC_FALSE)
 		{
 			if (dampener == AOC_FALSE)
 			{
-				continue;
+				return AOC_FALSE;
 			}
 
 			dampener = AOC_FALSE;
 			curr = last;
 		}
 
-		while ((early_exit == AOC_FALSE) 
-		&& ((token = strtok(NULL, " ")) != NULL))
+		if (i == len)
 		{
-			last = curr;
-			curr = extractValue(token);
+			return AOC_TRUE;
+		}
 
-			if (isSafe(direction, last, curr) == AOC_FALSE)
-			{
-				if (dampener == AOC_TRUE)
-				{
-					dampener = AOC_FALSE;
-					curr = last;
-				}
-				else
-				{
-					early_exit = AOC_TRUE;
-				}
-			}
+		last = curr;
+		curr = levels[i];
+	}
+}
+
+struct dayReports
+{
+	size_t num_safe;
+	size_t num_dampened_safe;
+};
+
+/* Each report is scanned once into a level array that's reused from line to
+ * line, and both rules are checked against it. Lines without any levels
+ * aren't reports */
+static void checkReports(const struct aocView *input, 
+	struct dayReports *reports)
+{
+	const char *line = NULL;
+	size_t line_len;
+	size_t cursor = 0;
+	long int *levels = NULL;
+	size_t max = 8;
+
+	AOC_NEW_DYN_ARR(long int, levels, max);
+	reports->num_safe = 0;
+	reports->num_dampened_safe = 0;
+
+	while (viewNextLine(input, &cursor, &line, &line_len) == AOC_TRUE)
+	{
+		struct aocCursor curs;
+		size_t len = 0;
+		long int level;
+
+		cursorInit(&curs, line, line_len);
+
+		while (scanNextLong(&curs, &level) == AOC_SUCCESS)
+		{
+			AOC_CAT_DYN_ARR(long int, levels, len, max, level);
+		}
+
+		if (len == 0)
+		{
+			continue;
+		}
+
+		if (isReportSafe(levels, len, AOC_FALSE) == AOC_TRUE)
+		{
+			reports->num_safe++;
 		}
 
-		if (early_exit == AOC_FALSE)
+		if (isReportSafe(levels, len, AOC_TRUE) == AOC_TRUE)
 		{
-			num_safe++;
+			reports->num_dampened_safe++;
 		}
 	}
 
-	return num_safe;
+	AOC_FREE(levels);
 }
 
-int main(int argc, char **argv)
+/* Both parts are counted in the one pass over the reports */
+static void* dayParse(const struct aocView *input)
 {
-	size_t i;
+	struct dayReports *reports = NULL;
 
-	if (argc < 2)
+	if ((reports = malloc(sizeof(struct dayReports))) == NULL)
 	{
-		fprintf(stderr, "Please provide an input file\n");
-
-		return AOC_FAILURE;
+		return NULL;
 	}
 
-	for (i = 1; i < argc; i++)
-	{
-		FILE *f_handle = NULL;
+	checkReports(input, reports);
 
-		if ((f_handle = fopen(argv[i], "rb")) == NULL)
-		{
-			fprintf(stderr, "Failed to open file '%s' for reading\n",
-				argv[i]);
+	return reports;
+}
 
-			return AOC_FAILURE;
-		}
+static AOC_STAT dayPart1(void *ctx, AOC_ACC *answer)
+{
+	const struct dayReports *reports = ctx;
 
-		fprintf(stdout, "undampened %d levels are safe\n", 
-			parseLevels(f_handle, AOC_FALSE));
-		rewind(f_handle);
-		fprintf(stdout, "dampened %d levels are safe\n", 
-			parseLevels(f_handle, AOC_TRUE));
-		fclose(f_handle);
-	}
+	*answer = reports->num_safe;
 
 	return AOC_SUCCESS;
 }
 
+static AOC_STAT dayPart2(void *ctx, AOC_ACC *answer)
+{
+	const struct dayReports *reports = ctx;
+
+	*answer = reports->num_dampened_safe;
+
+	return AOC_SUCCESS;
+}
+
+static void dayFree(void *ctx)
+{
+	AOC_FREE(ctx);
+}
+
+const struct aocDay aoc_day_02 =
+{
+	2, dayParse, dayPart1, dayPart2, dayFree,
+	"undampened %s levels are safe\n",
+	"dampened %s levels are safe\n"
+};
+
+#ifndef AOC_NO_MAIN
+int main(int argc, char **argv)
+{
+	return runDayMain(&aoc_day_02, argc, argv);
+}
+#endif /* AOC_NO_MAIN */
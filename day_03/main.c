@@ -4,66 +4,76 @@
 
 #include "../aocCommon.h"
 
-const char mul_str[]  = "mul(";
-const char do_str[]   = "do()";
-const char dont_str[] = "don't()";
-const size_t mul_len  = sizeof(mul_str) - 1;
-const size_t do_len   = sizeof(do_str) - 1;
-const size_t dont_len = sizeof(dont_str) - 1;
-
-/* Slurps the entire file into a null terminated buffer for later use
- * with strstr and sscanf */
-static char* slurpFile(FILE *f_handle)
+static const char mul_str[]  = "mul(";
+static const char do_str[]   = "do()";
+static const char dont_str[] = "don't()";
+static const size_t mul_len  = sizeof(mul_str) - 1;
+static const size_t do_len   = sizeof(do_str) - 1;
+static const size_t dont_len = sizeof(dont_str) - 1;
+
+/* Matches "mul(X,Y)" at the start of the cursor and adds the product to the
+ * total, leading whitespace ahead of either value is accepted as strtol did
+ * before. Anything that doesn't match adds nothing, only an overflowing
+ * total fails */
+static AOC_STAT addMul(struct aocCursor curs, AOC_ACC *total)
 {
-	const long int f_len = getFileLength(f_handle);
-	char *ret = NULL;
-
-	AOC_ASSERT(f_len != -1);
+	long int arg_1;
+	long int arg_2;
+	AOC_ACC product;
 
-	if (((ret = malloc(sizeof(char) * (f_len + 1))) == NULL)
-	|| (fread(ret, sizeof(char), f_len, f_handle) != f_len))
+	if (scanExpect(&curs, mul_str) != AOC_SUCCESS)
 	{
-		AOC_FREE(ret);
+		return AOC_SUCCESS;
+	}
 
-		return NULL;
+	scanSkipSpace(&curs);
+
+	if ((scanLong(&curs, &arg_1) != AOC_SUCCESS)
+	|| (scanExpect(&curs, ",") != AOC_SUCCESS))
+	{
+		return AOC_SUCCESS;
 	}
 
-	ret[f_len] = '\0';
+	scanSkipSpace(&curs);
 
-	return ret;
-}
+	if ((scanLong(&curs, &arg_2) != AOC_SUCCESS)
+	|| (scanExpect(&curs, ")") != AOC_SUCCESS))
+	{
+		return AOC_SUCCESS;
+	}
 
-static long int parseMul(const char *str)
-{
-	long int arg_1;
-	long int arg_2;
-	char check;
-
-	/* Without check sscanf will still report 2 matches even if the
-	 * closing parenthesis does not match because that count is 
-	 * incrimented when the match is made even if later parts of the 
-	 * format string do not match */
-	if ((sscanf(str, "mul(%ld,%ld%c", &arg_1, &arg_2, &check) == 3)
-	&& (check == ')'))
+	product = arg_1;
+
+	if ((accMul(&product, arg_2) != AOC_SUCCESS)
+	|| (accAdd(total, product) != AOC_SUCCESS))
 	{
-		return (arg_1 * arg_2);	
+		return AOC_FAILURE;
 	}
 
-	return 0;
+	return AOC_SUCCESS;
 }
 
-static unsigned long int parseInputPart1(const char *str)
+static AOC_STAT parseInputPart1(const struct aocView *input, 
+	AOC_ACC *running_total)
 {
-	unsigned long int running_total = 0;
-	const char *pos = str;
+	const char *pos = input->data;
+	struct aocCursor curs;
+
+	*running_total = 0;
 
 	while ((pos = strstr(pos, mul_str)) != NULL)
 	{
-		running_total += parseMul(pos);
+		cursorInit(&curs, pos, input->len - (pos - input->data));
+
+		if (addMul(curs, running_total) != AOC_SUCCESS)
+		{
+			return AOC_FAILURE;
+		}
+
 		pos += mul_len;
 	}
 
-	return running_total;
+	return AOC_SUCCESS;
 }
 
 enum needleID
@@ -116,13 +126,16 @@ static const char* getNextNeedle(const char *str, enum needleID *id)
 	return (best_pos == -1) ? NULL : str + best_pos;
 }
 
-static unsigned long int parseInputPart2(const char *str)
+static AOC_STAT parseInputPart2(const struct aocView *input,
+	AOC_ACC *running_total)
 {	
-	unsigned long int running_total = 0;
-	const char *pos = str;
+	const char *pos = input->data;
+	struct aocCursor curs;
 	enum needleID id = ID_ERROR;
 	AOC_BOOL is_active = AOC_TRUE;
 
+	*running_total = 0;
+
 	while ((pos = getNextNeedle(pos, &id)) != NULL)
 	{
 		switch (id)
@@ -130,7 +143,14 @@ static unsigned long int parseInputPart2(const char *str)
 			case ID_MUL:
 				if (is_active == AOC_TRUE)
 				{
-					running_total += parseMul(pos);
+					cursorInit(&curs, pos, input->len
+						- (pos - input->data));
+
+					if (addMul(curs, running_total)
+						!= AOC_SUCCESS)
+					{
+						return AOC_FAILURE;
+					}
 				}
 
 				pos += mul_len;
@@ -153,44 +173,41 @@ static unsigned long int parseInputPart2(const char *str)
 		}
 	}
 
-	return running_total;
+	return AOC_SUCCESS;
 }
 
-int main(int argc, char **argv)
+/* The memory is scanned straight out of the view so it doubles as the
+ * context and there is nothing to free */
+static void* dayParse(const struct aocView *input)
 {
-	size_t i;
-
-	if (argc < 2)
-	{
-		fputs("Please provide a file to act upon\n", stderr);
-
-		return AOC_FAILURE;
-	}
+	return (void *) input;
+}
 
-	for (i = 1; i < argc; i++)
-	{
-		FILE *f_handle = NULL;
-		char *slurped = NULL;
+static AOC_STAT dayPart1(void *ctx, AOC_ACC *answer)
+{
+	return parseInputPart1(ctx, answer);
+}
 
-		if ((f_handle = fopen(argv[i], "rb")) == NULL)
-		{
-			fprintf(stderr, 
-				"Unable to open file '%s' for reading\n",
-				argv[i]);
-		}
+static AOC_STAT dayPart2(void *ctx, AOC_ACC *answer)
+{
+	return parseInputPart2(ctx, answer);
+}
 
-		if ((slurped = slurpFile(f_handle)) != NULL)
-		{
-			fprintf(stdout, "Part 1: %lu\n", 
-				parseInputPart1(slurped));
-			fprintf(stdout, "Part 2: %lu\n", 
-				parseInputPart2(slurped));
-		}
+static void dayFree(void *ctx)
+{
+	(void) ctx;
+}
 
-		fclose(f_handle);
-		AOC_FREE(slurped);
-	}
+const struct aocDay aoc_day_03 =
+{
+	3, dayParse, dayPart1, dayPart2, dayFree,
+	"Part 1: %s\n",
+	"Part 2: %s\n"
+};
 
-	return AOC_SUCCESS;
+#ifndef AOC_NO_MAIN
+int main(int argc, char **argv)
+{
+	return runDayMain(&aoc_day_03, argc, argv);
 }
-
+#endif /* AOC_NO_MAIN */
@@ -4,14 +4,9 @@
 
 #include "../aocCommon.h"
 
-#define LINE_BUFFER_LEN (1024)
-
-struct searchGrid
-{
-	char **data;
-	size_t rows;
-	size_t cols;
-};
+/* Enough sentinel padding around the grid for a full length search to start
+ * on any edge cell without ever walking off of the allocation */
+#define GRID_PAD (sizeof("XMAS") - 2)
 
 enum gridDirection
 {
@@ -23,33 +18,29 @@ enum gridDirection
 	GRID_NUM_DIRS
 };
 
-static AOC_BOOL checkHeading(const struct searchGrid * const grid, 
-	const size_t x_pos, const size_t y_pos, const enum gridDirection x_dir, 
-	const enum gridDirection y_dir)
+static AOC_BOOL checkHeading(const struct aocGrid * const grid, 
+	const long int x_pos, const long int y_pos, 
+	const enum gridDirection x_dir, const enum gridDirection y_dir)
 {
 	const char target[] = "XMAS";
-	size_t i, j, curs = 0;
+	const long int step = AOC_GRID_OFFSET(grid, x_dir, y_dir);
+	const char *cell = &AOC_GRID_AT(grid, x_pos, y_pos);
+	size_t curs;
 
-	/* This is relying on underflow of the unsigned size_t values to then
-	 * be out of bounds of the grid and cause the for loop to break */
-	for (i = x_pos, j = y_pos; (i < grid->cols) && (j < grid->rows); 
-		i += x_dir, j += y_dir)
+	/* The sentinel padding never matches so leaving the grid just ends
+	 * the search like any other mismatch */
+	for (curs = 0; target[curs] != '\0'; curs++, cell += step)
 	{
-		if (grid->data[j][i] != target[curs++])
+		if (*cell != target[curs])
 		{
-			break;
-		}
-
-		if (target[curs] == '\0')
-		{
-			return AOC_TRUE;
+			return AOC_FALSE;
 		}
 	}
 
-	return AOC_FALSE;
+	return AOC_TRUE;
 }
 
-static unsigned long int searchPart1(const struct searchGrid * const grid)
+static unsigned long int searchPart1(const struct aocGrid * const grid)
 {
 	const struct 
 	{
@@ -75,7 +66,7 @@ static unsigned long int searchPart1(const struct searchGrid * const grid)
 	{
 		for (i = 0; i < grid->cols; i++)
 		{
-			if (grid->data[j][i] != 'X')
+			if (AOC_GRID_AT(grid, i, j) != 'X')
 			{
 				continue;
 			}
@@ -93,8 +84,8 @@ static unsigned long int searchPart1(const struct searchGrid * const grid)
 }
 
 /* This is a little sloppy but workable */
-static AOC_BOOL checkDiagonal(const struct searchGrid * const grid,
-	const size_t x_pos, const size_t y_pos, const AOC_BOOL is_left)
+static AOC_BOOL checkDiagonal(const struct aocGrid * const grid,
+	const long int x_pos, const long int y_pos, const AOC_BOOL is_left)
 {
 	int m_count = 0;
 	int s_count = 0;
@@ -103,23 +94,23 @@ static AOC_BOOL checkDiagonal(const struct searchGrid * const grid,
 	 * lower right or not */
 	if (is_left == AOC_TRUE)
 	{
-		m_count += grid->data[y_pos - 1][x_pos - 1] == 'M';
-		m_count += grid->data[y_pos + 1][x_pos + 1] == 'M';
-		s_count += grid->data[y_pos - 1][x_pos - 1] == 'S';
-		s_count += grid->data[y_pos + 1][x_pos + 1] == 'S';
+		m_count += AOC_GRID_AT(grid, x_pos - 1, y_pos - 1) == 'M';
+		m_count += AOC_GRID_AT(grid, x_pos + 1, y_pos + 1) == 'M';
+		s_count += AOC_GRID_AT(grid, x_pos - 1, y_pos - 1) == 'S';
+		s_count += AOC_GRID_AT(grid, x_pos + 1, y_pos + 1) == 'S';
 	}
 	else
 	{
-		m_count += grid->data[y_pos - 1][x_pos + 1] == 'M';
-		m_count += grid->data[y_pos + 1][x_pos - 1] == 'M';
-		s_count += grid->data[y_pos + 1][x_pos - 1] == 'S';
-		s_count += grid->data[y_pos - 1][x_pos + 1] == 'S';
+		m_count += AOC_GRID_AT(grid, x_pos + 1, y_pos - 1) == 'M';
+		m_count += AOC_GRID_AT(grid, x_pos - 1, y_pos + 1) == 'M';
+		s_count += AOC_GRID_AT(grid, x_pos - 1, y_pos + 1) == 'S';
+		s_count += AOC_GRID_AT(grid, x_pos + 1, y_pos - 1) == 'S';
 	}
 
 	return ((m_count == 1) && (s_count == 1));
 }
 
-static unsigned long int searchPart2(const struct searchGrid * const grid)
+static unsigned long int searchPart2(const struct aocGrid * const grid)
 {
 	unsigned long int num_found = 0;
 	size_t i, j;
@@ -127,11 +118,11 @@ static unsigned long int searchPart2(const struct searchGrid * const grid)
 	/* Only looking for centers in these loops and these more limited 
 	 * bounds ensure that there won't be out of bound accesses when 
 	 * checking the diagonals */
-	for (j = 1; j < grid->rows - 1; j++)
+	for (j = 1; j + 1 < grid->rows; j++)
 	{
-		for (i = 1; i < grid->cols - 1; i++)
+		for (i = 1; i + 1 < grid->cols; i++)
 		{
-			if (grid->data[j][i] != 'A')
+			if (AOC_GRID_AT(grid, i, j) != 'A')
 			{
 				continue;
 			}
@@ -147,110 +138,60 @@ static unsigned long int searchPart2(const struct searchGrid * const grid)
 	return num_found;
 }
 
-static void freeGrid(struct searchGrid *grid)
-{
-	size_t i;
-
-	if (grid != NULL)
-	{
-		for (i = 0; i < grid->rows; i++)
-		{
-			AOC_FREE(grid->data[i]);
-		}
-
-		AOC_FREE(grid->data);
-		AOC_FREE(grid);
-	}
-}
-
-/* It might be easier to have fgets read directly into a prepared buffer in
- * the grid, as all the rows are the same length, but this is just cleaner at
- * the moment and doesn't require trimming a trailing prepared but unused 
- * buffer */
-static struct searchGrid* slurpFileToGrid(FILE *input)
+static void* dayParse(const struct aocView *input)
 {
-	char buffer[LINE_BUFFER_LEN] = {0};
-	struct searchGrid *grid = calloc(1, sizeof(struct searchGrid));
-	size_t max = 10;
+	struct aocGrid *grid = NULL;
 
-	if ((input == NULL) || (grid == NULL))
+	if ((grid = malloc(sizeof(struct aocGrid))) == NULL)
 	{
 		return NULL;
 	}
 
-	AOC_NEW_DYN_ARR(char *, grid->data, max);
-
-	while (fgets(buffer, LINE_BUFFER_LEN, input) != NULL)
+	if (gridLoad(input, grid, GRID_PAD, '\0') != AOC_SUCCESS)
 	{
-		/* There is no reason to include the newline character */
-		const size_t line_len = strlen(buffer) - 1;		
-
-		/* Realistically this should be checked for each row input as
-		 * they all need to be the same length */
-		grid->cols = line_len;
-
-		if (grid->rows == max)
-		{
-			AOC_GROW_DYN_ARR(char *, grid->data, max);
-		}
-
-		grid->data[grid->rows] = malloc(sizeof(char) * (line_len + 1));
-
-		if (grid->data[grid->rows] == NULL)
-		{
-			freeGrid(grid);
-
-			return NULL;
-		}
+		AOC_FREE(grid);
 
-		memcpy(grid->data[grid->rows], buffer, line_len);
-		grid->data[grid->rows][line_len] = '\0';
-		grid->rows++;
+		return NULL;
 	}
 
 	return grid;
 }
 
-int main(int argc, char **argv)
+static AOC_STAT dayPart1(void *ctx, AOC_ACC *answer)
 {
-	size_t i;
-
-	if (argc < 2)
-	{
-		fputs("Please provide a file to act upon\n", stderr);
-		
-		return AOC_FAILURE;
-	}
-
-	for (i = 1; i < argc; i++)
-	{
-		FILE *input;
-		struct searchGrid *grid = NULL;
+	*answer = searchPart1(ctx);
 
-		if ((input = fopen(argv[i], "rb")) == NULL)
-		{
-			fprintf(stderr, 
-				"Unable to open file '%s' for reading\n",
-				argv[i]);
+	return AOC_SUCCESS;
+}
 
-			return AOC_FAILURE;
-		}
+static AOC_STAT dayPart2(void *ctx, AOC_ACC *answer)
+{
+	*answer = searchPart2(ctx);
 
-		if ((grid = slurpFileToGrid(input)) == NULL)
-		{
-			fputs("Failed to parse input into search grid\n", 
-				stderr);
-			fclose(input);
+	return AOC_SUCCESS;
+}
 
-			return AOC_FAILURE;
-		}
+static void dayFree(void *ctx)
+{
+	struct aocGrid *grid = ctx;
 
-		fprintf(stdout, "Part 1: %lu matches\n", searchPart1(grid));
-		fprintf(stdout, "Part 2: %lu matches\n", searchPart2(grid));
-		freeGrid(grid);
-		fclose(input);
+	if (grid != NULL)
+	{
+		gridFree(grid);
+		AOC_FREE(grid);
 	}
-
-	return AOC_SUCCESS;
 }
 
+const struct aocDay aoc_day_04 =
+{
+	4, dayParse, dayPart1, dayPart2, dayFree,
+	"Part 1: %s matches\n",
+	"Part 2: %s matches\n"
+};
+
+#ifndef AOC_NO_MAIN
+int main(int argc, char **argv)
+{
+	return runDayMain(&aoc_day_04, argc, argv);
+}
+#endif /* AOC_NO_MAIN */
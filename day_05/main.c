@@ -1,12 +1,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <errno.h>
 
 #include "../aocCommon.h"
 
-#define BUFFER_LEN (256)
-
 struct pageReport
 {
 	int *vals;
@@ -19,88 +16,156 @@ struct pageRule
 	int right;
 };
 
-static long int extractValue(const char * const str)
-{
-	long int ret;
+/* Rules are ordered by their left page and then their right */
+#define RULE_LESS(foo, bar)                                     \
+	(((foo).left < (bar).left)                              \
+	|| (((foo).left == (bar).left) && ((foo).right < (bar).right)))
 
-	errno = 0;
-	ret = strtol(str, NULL, 0);
-	AOC_ASSERT(errno == 0);
+AOC_DEFINE_INTRO_SORT(sortRules, struct pageRule, RULE_LESS)
+AOC_DEFINE_EYTZINGER(ruleTree, struct pageRule, RULE_LESS)
 
-	return ret;
+/* The rules are only ever searched once loaded so they are kept in
+ * Eytzinger order, see parseFile */
+static AOC_BOOL hasRule(const struct pageRule *rules, const size_t num_rules,
+	const struct pageRule key)
+{
+	const size_t node = ruleTreeLowerBound(rules, num_rules, key);
+
+	return (node != 0) && (rules[node].left == key.left)
+		&& (rules[node].right == key.right);
 }
 
-static int compareRules(const void *left, const void *right)
+/* Offset of the blank line between the rules and the reports, or the end of
+ * the input when there isn't one */
+static size_t findSectionBreak(const struct aocView *input)
 {
-	const struct pageRule * const foo = (struct pageRule *) left;
-	const struct pageRule * const bar = (struct pageRule *) right;
+	const char *pos = strstr(input->data, "\n\n");
 
-	return (foo->left == bar->left) 
-		? foo->right - bar->right
-		: foo->left - bar->left;
+	if (pos == NULL)
+	{
+		pos = strstr(input->data, "\n\r\n");
+	}
+
+	return (pos == NULL) ? input->len : (size_t) (pos - input->data);
 }
 
-AOC_STAT parseFile(FILE *input, struct pageRule **rules, size_t *num_rules,
-	struct pageReport **reports, size_t *num_reports)
+static AOC_STAT parseFile(const struct aocView *input, struct pageRule **rules, 
+	size_t *num_rules, struct pageReport **reports, size_t *num_reports)
 {
-	char buffer[BUFFER_LEN] = {0};
+	struct pageRule *tree = NULL;
+	const char *line = NULL;
+	size_t line_len;
+	size_t cursor = 0;
 	size_t len = 0;
-	size_t max = 10;
+	size_t max = 0;
+	size_t section_break;
 
 	if ((input == NULL) || (rules == NULL) || (reports == NULL))
 	{
 		return AOC_FAILURE;
 	}
 
-	AOC_NEW_DYN_ARR(struct pageRule, (*rules), max);
+	/* Both sections are sized from their share of the input so that
+	 * neither array needs to grow while parsing */
+	section_break = findSectionBreak(input);
+	*rules = NULL;
+	AOC_RESERVE_DYN_ARR(struct pageRule, (*rules), max,
+		viewEstimateLines(input, 0, section_break));
 
 	/* Parse the page rules, go until either the end of the file is
 	 * encountered or until the blank line separating the rules and 
 	 * report sections */
-	while ((fgets(buffer, BUFFER_LEN, input) != NULL)
-	&& (buffer[0] != '\n'))
+	while ((viewNextLine(input, &cursor, &line, &line_len) == AOC_TRUE)
+	&& (line_len != 0))
 	{
 		struct pageRule tmp = {0};
+		struct aocCursor curs;
+		long int left;
+		long int right;
 
-		if (sscanf(buffer, "%d|%d\n", &tmp.left, &tmp.right) != 2)
+		cursorInit(&curs, line, line_len);
+
+		if ((scanLong(&curs, &left) != AOC_SUCCESS)
+		|| (scanExpect(&curs, "|") != AOC_SUCCESS)
+		|| (scanLong(&curs, &right) != AOC_SUCCESS)
+		|| (left < INT_MIN) || (left > INT_MAX)
+		|| (right < INT_MIN) || (right > INT_MAX))
 		{
 			fprintf(stderr, "Malformed page rules\n");
 
 			return AOC_FAILURE;
 		}
 
+		tmp.left = left;
+		tmp.right = right;
 		AOC_CAT_DYN_ARR(struct pageRule, (*rules), len, max, tmp);
 	}
 
-	qsort((*rules), len, sizeof(struct pageRule), compareRules);
+	/* Swap the sorted rules for the search tree built from them */
+	sortRules((*rules), len);
+	AOC_NEW_DYN_ARR(struct pageRule, tree, len + 1);
+	ruleTreeBuild((*rules), tree, len);
+	AOC_FREE((*rules));
+	*rules = tree;
 	*num_rules = len;
 
-	max = 10;
+	max = 0;
 	len = 0;
-	AOC_NEW_DYN_ARR(struct pageReport, (*reports), max);
+	*reports = NULL;
+	AOC_RESERVE_DYN_ARR(struct pageReport, (*reports), max,
+		viewEstimateLines(input, cursor, input->len));
 
-	/* Parse the page reports until the end of the file */
-	while (fgets(buffer, BUFFER_LEN, input) != NULL)
+	/* Parse the page reports until the end of the file, the values are
+	 * walked in place rather than tokenized out of a copy */
+	while (viewNextLine(input, &cursor, &line, &line_len) == AOC_TRUE)
 	{
+		struct aocCursor curs;
+		long int val;
 		int *val_arr = NULL;
-		char *token = NULL;
 		size_t val_len = 0;
-		size_t val_max = 10;
+		size_t val_max = 0;
 
-		token = strtok(buffer, ",");
+		if (line_len == 0)
+		{
+			continue;
+		}
 
 		if (len == max)
 		{
 			AOC_GROW_DYN_ARR(struct pageReport, (*reports), max);
 		}
 
-		AOC_NEW_DYN_ARR(int, val_arr, val_max);
+		/* Every page takes at least a digit and a comma */
+		AOC_RESERVE_DYN_ARR(int, val_arr, val_max, (line_len / 2) + 1);
+		cursorInit(&curs, line, line_len);
 
-		do
+		while (scanLong(&curs, &val) == AOC_SUCCESS)
 		{
+			if ((val < INT_MIN) || (val > INT_MAX))
+			{
+				fprintf(stderr, "Page number out of range\n");
+				AOC_FREE(val_arr);
+				*num_reports = len;
+
+				return AOC_FAILURE;
+			}
+
 			AOC_CAT_DYN_ARR(int, val_arr, val_len, val_max, 
-				extractValue(token));
-		} while ((token = strtok(NULL, ",")) != NULL);
+				(int) val);
+
+			if (scanExpect(&curs, ",") != AOC_SUCCESS)
+			{
+				break;
+			}
+		}
+
+		/* A line without a single page isn't a report */
+		if (val_len == 0)
+		{
+			AOC_FREE(val_arr);
+
+			continue;
+		}
 
 		(*reports)[len].vals = val_arr;
 		(*reports)[len].len = val_len;
@@ -127,35 +192,38 @@ static void freeReports(struct pageReport *reports, const size_t len)
 	}
 }
 
-static long int calculatePart1(const struct pageRule *rules, 
+static AOC_STAT calculatePart1(const struct pageRule *rules, 
 	const size_t num_rules, const struct pageReport *reports, 
-	const size_t num_reports)
+	const size_t num_reports, AOC_ACC *total)
 {
-	long int ret = 0;
 	size_t i, j, k;
 
+	*total = 0;
+
 	for (i = 0; i < num_reports; i++)
 	{
 		AOC_BOOL is_valid = AOC_TRUE;
 
+		if (reports[i].len == 0)
+		{
+			continue;
+		}
+
 		/* Can short circuit out with is_valid as soon as an invalid
 		 * rule is found */
-		for (j = 0; (j < reports[i].len - 1) && (is_valid == AOC_TRUE); 
+		for (j = 0; (j + 1 < reports[i].len) && (is_valid == AOC_TRUE); 
 			j++)
 		{
 			for (k = j; k < reports[i].len; k++)
 			{
 				struct pageRule key = {0};
-				struct pageRule *found = NULL;
 
 				/* Checks for a rule directly conflicting 
 				 * with the observed order */
 				key.left  = reports[i].vals[k];
 				key.right = reports[i].vals[j];
 
-				if ((found = bsearch(&key, rules, num_rules, 
-					sizeof(struct pageRule), compareRules))
-						!= NULL)
+				if (hasRule(rules, num_rules, key) == AOC_TRUE)
 				{
 					is_valid = AOC_FALSE;
 
@@ -167,11 +235,16 @@ static long int calculatePart1(const struct pageRule *rules,
 		if (is_valid == AOC_TRUE)
 		{
 			AOC_ASSERT(reports[i].len % 2 != 0);
-			ret += (reports[i].vals[(reports[i].len >> 1)]);
+
+			if (accAdd(total, reports[i].vals[reports[i].len >> 1])
+				!= AOC_SUCCESS)
+			{
+				return AOC_FAILURE;
+			}
 		}
 	}
 
-	return ret;
+	return AOC_SUCCESS;
 }
 
 /* There is likely a better way to accomplish this besides what here is 
@@ -196,19 +269,16 @@ static AOC_BOOL fixReport(const struct pageRule *rules, const size_t num_rules,
 	{
 		is_fixed = AOC_TRUE;
 
-		for (i = 0; i < report->len - 1; i++)
+		for (i = 0; i + 1 < report->len; i++)
 		{
 			for (j = i; j < report->len; j++)
 			{
 				struct pageRule key = {0};
-				struct pageRule *found = NULL;
 
 				key.left  = report->vals[j];
 				key.right = report->vals[i];
 
-				if ((found = bsearch(&key, rules, num_rules, 
-					sizeof(struct pageRule), compareRules)) 
-						!= NULL)
+				if (hasRule(rules, num_rules, key) == AOC_TRUE)
 				{
 					already_valid = AOC_FALSE;
 					is_fixed = AOC_FALSE;
@@ -222,85 +292,104 @@ static AOC_BOOL fixReport(const struct pageRule *rules, const size_t num_rules,
 	return already_valid;
 }
 
-static long int calculatePart2(const struct pageRule *rules, 
+static AOC_STAT calculatePart2(const struct pageRule *rules, 
 	const size_t num_rules, struct pageReport *reports, 
-	const size_t num_reports)
+	const size_t num_reports, AOC_ACC *total)
 {
-	long int ret = 0;
 	size_t i;
 
+	*total = 0;
+
 	for (i = 0; i < num_reports; i++)
 	{
 		const AOC_BOOL already_valid = fixReport(rules, num_rules,
 			&reports[i]);
 
-		if (already_valid == AOC_FALSE)
+		if ((already_valid == AOC_FALSE) && (reports[i].len > 0))
 		{
 			/* Asserts that the report processing has remedied the
 			 * error */
 			AOC_ASSERT(fixReport(rules, num_rules, 
 				&reports[i]) == AOC_TRUE);
 			AOC_ASSERT(reports[i].len % 2 != 0);
-			ret += (reports[i].vals[(reports[i].len >> 1)]);
+
+			if (accAdd(total, reports[i].vals[reports[i].len >> 1])
+				!= AOC_SUCCESS)
+			{
+				return AOC_FAILURE;
+			}
 		}
 	}
 
-	return ret;
+	return AOC_SUCCESS;
 }
 
-int main(int argc, char **argv)
+struct dayInput
 {
-	size_t i;
+	struct pageRule *rules;
+	struct pageReport *reports;
+	size_t num_rules;
+	size_t num_reports;
+};
 
-	if (argc < 2)
-	{
-		fputs("Please supply an input file or files to act upon\n", 
-			stderr);
+static void dayFree(void *ctx)
+{
+	struct dayInput *in = ctx;
 
-		return AOC_FAILURE;
+	if (in != NULL)
+	{
+		AOC_FREE(in->rules);
+		freeReports(in->reports, in->num_reports);
+		AOC_FREE(in);
 	}
+}
+
+static void* dayParse(const struct aocView *input)
+{
+	struct dayInput *in = NULL;
 
-	for (i = 1; i < argc; i++)
+	if ((in = calloc(1, sizeof(struct dayInput))) == NULL)
 	{
-		struct pageReport *page_reports = NULL;
-		struct pageRule *page_rules = NULL;
-		size_t num_reports = 0;
-		size_t num_rules = 0;
-		FILE *input = NULL;
+		return NULL;
+	}
 
-		if ((input = fopen(argv[i], "rb")) == NULL)
-		{
-			fprintf(stderr, 
-				"Unable to open file '%s' for reading\n", 
-				argv[i]);
+	if (parseFile(input, &in->rules, &in->num_rules, &in->reports, 
+		&in->num_reports) != AOC_SUCCESS)
+	{
+		dayFree(in);
 
-			return AOC_FAILURE;
-		}
+		return NULL;
+	}
 
-		if (parseFile(input, &page_rules, &num_rules, &page_reports, 
-			&num_reports) != AOC_SUCCESS)
-		{
-			fprintf(stderr, "Failed to parse input file '%s'\n", 
-				argv[1]);
-			AOC_FREE(page_rules);
-			freeReports(page_reports, num_reports);
-			fclose(input);
+	return in;
+}
 
-			return AOC_FAILURE;
-		}
+static AOC_STAT dayPart1(void *ctx, AOC_ACC *answer)
+{
+	const struct dayInput *in = ctx;
 
-		fprintf(stdout, "Part 1: %ld\n", 
-			calculatePart1(page_rules, num_rules, page_reports, 
-				num_reports));
-		fprintf(stdout, "Part 2: %ld\n", 
-			calculatePart2(page_rules, num_rules, page_reports, 
-				num_reports));
+	return calculatePart1(in->rules, in->num_rules, in->reports, 
+		in->num_reports, answer);
+}
 
-		AOC_FREE(page_rules);
-		freeReports(page_reports, num_reports);
-		fclose(input);
-	}
+static AOC_STAT dayPart2(void *ctx, AOC_ACC *answer)
+{
+	const struct dayInput *in = ctx;
 
-	return AOC_SUCCESS;
+	return calculatePart2(in->rules, in->num_rules, in->reports, 
+		in->num_reports, answer);
 }
 
+const struct aocDay aoc_day_05 =
+{
+	5, dayParse, dayPart1, dayPart2, dayFree,
+	"Part 1: %s\n",
+	"Part 2: %s\n"
+};
+
+#ifndef AOC_NO_MAIN
+int main(int argc, char **argv)
+{
+	return runDayMain(&aoc_day_05, argc, argv);
+}
+#endif /* AOC_NO_MAIN */
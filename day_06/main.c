@@ -4,7 +4,8 @@
 
 #include "../aocCommon.h"
 
-#define BUFFER_LEN (1024)
+/* Sentinel surrounding the map, stepping onto it means the guard has left */
+#define MAP_EDGE ('\0')
 
 enum direction
 {
@@ -17,12 +18,12 @@ enum direction
 
 struct coordinate
 {
-	size_t x_pos;
-	size_t y_pos;
+	long int x_pos;
+	long int y_pos;
 };
 
 /* Directional unit vectors */
-const struct coordinate dir_map[] =
+static const struct coordinate dir_map[] =
 {
 	{0, -1}, /* NORTH */
 	{1,  0}, /* EAST */
@@ -30,69 +31,23 @@ const struct coordinate dir_map[] =
 	{-1, 0}  /* WEST */
 };
 
-struct guardMap
-{
-	char **data;
-	size_t rows;
-	size_t cols;
-};
-
-static AOC_STAT parseInput(FILE *input, struct guardMap *map)
-{
-	char buffer[BUFFER_LEN] = {0};
-	size_t len = 0;
-	size_t max = 10;
-	
-	if ((input == NULL) || (map == NULL))
-	{
-		return AOC_FAILURE;
-	}
-
-	AOC_NEW_DYN_ARR(char *, map->data, max);
-
-	while (fgets(buffer, BUFFER_LEN, input) != NULL)
-	{
-		/* No need for the newline character */
-		map->cols = strlen(buffer) - 1;
-
-		if (len == max)
-		{
-			AOC_GROW_DYN_ARR(char *, map->data, max);
-		}
-
-		/* Accomidate a null terminator to make printing simple */
-		if ((map->data[len] = malloc(sizeof(char) * (map->cols + 1))) 
-			== NULL)
-		{
-			return AOC_FAILURE;
-		}
-
-		memcpy(map->data[len], buffer, map->cols);
-		map->data[len][map->cols] = '\0';
-		len++;
-	}
-
-	map->rows = len;
-
-	return AOC_SUCCESS;
-}
-
 /* XXX: This assumes that the guard is always starting facing the northward
  * direction. This seems to be the case in the puzzle example as well as in
  * the input but the question description does not explicitly state that this 
  * is a requirement */
-static AOC_STAT findGuard(const struct guardMap map, 
+static AOC_STAT findGuard(const struct aocGrid map, 
 	struct coordinate *guard_pos)
 {
 	size_t i; 
 
 	for (i = 0; i < map.rows; i++)
 	{
-		char *found = strstr(map.data[i], "^");
+		const char *row = &AOC_GRID_AT(&map, 0, i);
+		const char *found = memchr(row, '^', map.cols);
 
 		if (found != NULL)
 		{
-			(*guard_pos).x_pos = found - map.data[i];
+			(*guard_pos).x_pos = found - row;
 			(*guard_pos).y_pos = i;
 
 			return AOC_SUCCESS;
@@ -102,29 +57,28 @@ static AOC_STAT findGuard(const struct guardMap map,
 	return AOC_FAILURE;
 }
 
-static long int calculatePart1(struct guardMap map, struct coordinate guard)
+static long int calculatePart1(struct aocGrid map, struct coordinate guard)
 {
 	long int unique = 0;
 	size_t curr_dir = DIR_NORTH; 
 
-	while ((guard.x_pos < map.cols) && (guard.y_pos < map.rows))
+	while (AOC_GRID_AT(&map, guard.x_pos, guard.y_pos) != MAP_EDGE)
 	{
-		const size_t new_x = guard.x_pos + dir_map[curr_dir].x_pos;
-		const size_t new_y = guard.y_pos + dir_map[curr_dir].y_pos;
+		const long int new_x = guard.x_pos + dir_map[curr_dir].x_pos;
+		const long int new_y = guard.y_pos + dir_map[curr_dir].y_pos;
 
-		if ((new_x < map.cols) && (new_y < map.rows)
-		&& (map.data[new_y][new_x] == '#'))
+		if (AOC_GRID_AT(&map, new_x, new_y) == '#')
 		{
 			curr_dir = ((curr_dir + 1) % DIR_NUM);
 		}
 		else
 		{
-			if (map.data[guard.y_pos][guard.x_pos] != '%')
+			if (AOC_GRID_AT(&map, guard.x_pos, guard.y_pos) != '%')
 			{
 				unique++;
 			}
 
-			map.data[guard.y_pos][guard.x_pos] = '%';
+			AOC_GRID_AT(&map, guard.x_pos, guard.y_pos) = '%';
 			guard.x_pos = new_x;
 			guard.y_pos = new_y;
 		}
@@ -133,84 +87,51 @@ static long int calculatePart1(struct guardMap map, struct coordinate guard)
 	return unique;
 }
 
-struct pivotPoint 
-{
-	struct coordinate position;
-	enum direction heading;
-}; 
-
-static int comparePivotPoints(const void *left, const void *right)
-{
-	const struct pivotPoint *tmp_l = (struct pivotPoint *) left;
-	const struct pivotPoint *tmp_r = (struct pivotPoint *) right;
-
-	if (tmp_l->heading != tmp_r->heading)
-	{
-		return tmp_l->heading - tmp_r->heading;	
-	}
-	else if (tmp_l->position.y_pos != tmp_r->position.y_pos)
-	{
-		return tmp_l->position.y_pos - tmp_r->position.y_pos;	
-	}
-	else
-	{
-		return tmp_l->position.x_pos - tmp_r->position.x_pos;	
-	}
-}
+/* Pivot points are keyed by the guard's cell and heading together */
+#define PIVOT_KEY(map, pos, heading)                                  \
+	((AOC_HASH_KEY(AOC_GRID_OFFSET((map), (pos).x_pos, (pos).y_pos)) \
+		* DIR_NUM) + (heading))
 
 /* Proceed until the edge of the map is reached or the hypothetical guard 
  * visits a pivot point they have already been at with the same heading. Saves
  * a little bit of time by having the guard always start at the current 
- * position instead of all the way back at the beginning each time */
-
-/* One bit of easy savings would be to manage visited's allocation outside
- * of this function so that it only has to get initially allocated and 
- * dealloced the once, only len would need to be reset each time */
-static AOC_BOOL isPosInfinite(struct guardMap map, 
-	struct coordinate guard, enum direction heading)
+ * position instead of all the way back at the beginning each time. The
+ * visited set belongs to the caller and is cleared here so that its storage
+ * is reused between obstacles */
+static AOC_BOOL isPosInfinite(struct aocGrid map, 
+	struct coordinate guard, enum direction heading, 
+	struct aocHash *visited)
 {
-	const size_t obs_x = guard.x_pos + dir_map[heading].x_pos;
-	const size_t obs_y = guard.y_pos + dir_map[heading].y_pos;
-	struct pivotPoint *visited = NULL;
-	size_t len = 0;
-	size_t max = 10;
+	const long int obs_x = guard.x_pos + dir_map[heading].x_pos;
+	const long int obs_y = guard.y_pos + dir_map[heading].y_pos;
 	AOC_BOOL is_infinite = AOC_FALSE;
 
-	map.data[obs_y][obs_x] = '#';
-	AOC_NEW_DYN_ARR(struct pivotPoint, visited, max);
+	AOC_TRACE_BEGIN("isPosInfinite");
+	AOC_GRID_AT(&map, obs_x, obs_y) = '#';
+	hashClear(visited);
 
 	for (;;)
 	{
-		const size_t new_x = guard.x_pos + dir_map[heading].x_pos;
-		const size_t new_y = guard.y_pos + dir_map[heading].y_pos;
+		const long int new_x = guard.x_pos + dir_map[heading].x_pos;
+		const long int new_y = guard.y_pos + dir_map[heading].y_pos;
+		const char next = AOC_GRID_AT(&map, new_x, new_y);
 
-		if ((new_x >= map.cols) || (new_y >= map.rows))
+		if (next == MAP_EDGE)
 		{
 			break;
 		}
 
-		if (map.data[new_y][new_x] == '#')
+		if (next == '#')
 		{
-			struct pivotPoint tmp = {0};
-			struct pivotPoint *found = NULL;
-
-			tmp.position = guard;
-			tmp.heading = heading;
-			heading = ((heading + 1) % DIR_NUM);
-
-			if ((found = bsearch(&tmp, visited, len, 
-				sizeof(struct pivotPoint), comparePivotPoints)) 
-					!= NULL)
+			if (hashInsert(visited, PIVOT_KEY(&map, guard, heading),
+				NULL) == AOC_FALSE)
 			{
 				is_infinite = AOC_TRUE;
 
 				break;
 			}
-			else
-			{
-				AOC_INSERT_CAT(struct pivotPoint, visited, 
-					len, max, tmp, comparePivotPoints);
-			}
+
+			heading = ((heading + 1) % DIR_NUM);
 		}
 		else
 		{
@@ -219,118 +140,138 @@ static AOC_BOOL isPosInfinite(struct guardMap map,
 		}
 	}
 
-	map.data[obs_y][obs_x] = '.';
-	AOC_FREE(visited);
+	AOC_GRID_AT(&map, obs_x, obs_y) = '.';
+	AOC_TRACE_END("isPosInfinite");
 
 	return is_infinite;
 }
 
-static long int calculatePart2(struct guardMap map, struct coordinate guard)
+static long int calculatePart2(struct aocGrid map, struct coordinate guard)
 {
-	struct pivotPoint *tested = NULL;
+	struct aocHash tested = {0};
+	struct aocHash visited = {0};
 	enum direction curr_dir = DIR_NORTH;
 	long int infinite_positions = 0;
-	size_t len = 0;
-	size_t max = 10;
 
-	/* Heading is a dummy value for these */
-	AOC_NEW_DYN_ARR(struct pivotPoint, tested, max);
-	tested[0].position = guard;
-	tested[0].heading = 0;
-	len++;
+	/* Sized for a guard that covers most of the map */
+	hashInit(&tested, map.rows * map.cols, AOC_FALSE);
+	hashInit(&visited, 0, AOC_FALSE);
+	hashInsert(&tested, AOC_HASH_KEY(AOC_GRID_OFFSET(&map, guard.x_pos,
+		guard.y_pos)), NULL);
 
 	for (;;)
 	{
-		const size_t new_x = guard.x_pos + dir_map[curr_dir].x_pos;
-		const size_t new_y = guard.y_pos + dir_map[curr_dir].y_pos;
+		const long int new_x = guard.x_pos + dir_map[curr_dir].x_pos;
+		const long int new_y = guard.y_pos + dir_map[curr_dir].y_pos;
+		const char next = AOC_GRID_AT(&map, new_x, new_y);
 
-		if ((new_x >= map.cols) || (new_y >= map.rows))
+		if (next == MAP_EDGE)
 		{
 			break;
 		}
 
-		if (map.data[new_y][new_x] == '#')
+		if (next == '#')
 		{
 			curr_dir = ((curr_dir + 1) % DIR_NUM);
 		}
 		else
 		{
-			struct pivotPoint key;
-			struct pivotPoint *found = NULL;
-
-			key.position.x_pos = new_x;
-			key.position.y_pos = new_y;
-			key.heading = 0;
-
-			if ((found = bsearch(&key, tested, len, 
-				sizeof(struct pivotPoint), comparePivotPoints)) 
-					== NULL)
+			if (hashInsert(&tested, AOC_HASH_KEY(AOC_GRID_OFFSET(
+				&map, new_x, new_y)), NULL) == AOC_TRUE)
 			{
-				infinite_positions 
-					+= isPosInfinite(map, guard, curr_dir);
-				AOC_INSERT_CAT(struct pivotPoint, tested, len, 
-					max, key, comparePivotPoints);
+				infinite_positions += isPosInfinite(map, guard,
+					curr_dir, &visited);
+				AOC_TRACE_COUNTER("infinite positions",
+					infinite_positions);
 			}
 
-			guard = key.position;
+			guard.x_pos = new_x;
+			guard.y_pos = new_y;
 		}
 	}
 
-	AOC_FREE(tested);
+	hashFree(&tested);
+	hashFree(&visited);
 
 	return infinite_positions;
 }
 
-static void freeMap(struct guardMap *map)
+struct dayInput
 {
-	if (map != NULL)
-	{
-		size_t i;
+	struct aocGrid map;
+	struct coordinate guard;
+};
 
-		for (i = 0; i < map->rows; i++)
-		{
-			AOC_FREE(map->data[i]);
-		}
+static void* dayParse(const struct aocView *input)
+{
+	struct dayInput *in = NULL;
 
-		AOC_FREE(map->data);
+	if ((in = malloc(sizeof(struct dayInput))) == NULL)
+	{
+		return NULL;
 	}
-}
 
-int main(int argc, char **argv)
-{
-	size_t i;
-
-	if (argc < 2)
+	if (gridLoad(input, &in->map, 1, MAP_EDGE) != AOC_SUCCESS)
 	{
-		fprintf(stderr, 
-			"Please provide a file or files to act upon\n");
+		AOC_FREE(in);
 
-		return AOC_FAILURE;
+		return NULL;
 	}
 
-	for (i = 1; i < argc; i++)
+	/* An empty map has no guard to walk so both answers are 0 */
+	if ((in->map.rows != 0) 
+	&& (findGuard(in->map, &in->guard) != AOC_SUCCESS))
 	{
-		FILE *input = NULL;
-		struct guardMap map = {0};
-		struct coordinate guard = {0};
+		gridFree(&in->map);
+		AOC_FREE(in);
 
-		if ((input = fopen(argv[i], "rb")) == NULL)
-		{
-			return AOC_FAILURE;
-		}
+		return NULL;
+	}
 
-		if ((parseInput(input, &map) != AOC_SUCCESS)
-		|| (findGuard(map, &guard) != AOC_SUCCESS))
-		{
-			return AOC_FAILURE;
-		}
+	return in;
+}
 
-		fprintf(stdout, "Part 1: %lu\n", calculatePart1(map, guard));
-		fprintf(stdout, "Part 2: %lu\n", calculatePart2(map, guard));
-		freeMap(&map);
-		fclose(input);
-	}
+static AOC_STAT dayPart1(void *ctx, AOC_ACC *answer)
+{
+	const struct dayInput *in = ctx;
+
+	*answer = (in->map.rows == 0) ? 0 
+		: calculatePart1(in->map, in->guard);
+
+	return AOC_SUCCESS;
+}
+
+static AOC_STAT dayPart2(void *ctx, AOC_ACC *answer)
+{
+	const struct dayInput *in = ctx;
+
+	*answer = (in->map.rows == 0) ? 0 
+		: calculatePart2(in->map, in->guard);
 
 	return AOC_SUCCESS;
 }
 
+static void dayFree(void *ctx)
+{
+	struct dayInput *in = ctx;
+
+	if (in != NULL)
+	{
+		gridFree(&in->map);
+		AOC_FREE(in);
+	}
+}
+
+const struct aocDay aoc_day_06 =
+{
+	6, dayParse, dayPart1, dayPart2, dayFree,
+	"Part 1: %s\n",
+	"Part 2: %s\n"
+};
+
+#ifndef AOC_NO_MAIN
+int main(int argc, char **argv)
+{
+	return runDayMain(&aoc_day_06, argc, argv);
+}
+#endif /* AOC_NO_MAIN */
@@ -1,15 +1,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <errno.h>
 
 #include "../aocCommon.h"
 
-#define BUFFER_LEN (1024)
-
-static long int addOperator(const long int left, const long int right);
-static long int multiplyOperator(const long int left, const long int right);
-static long int combineOperator(const long int left, const long int right);
+static AOC_STAT addOperator(AOC_ACC *running, const AOC_ACC right);
+static AOC_STAT multiplyOperator(AOC_ACC *running, const AOC_ACC right);
+static AOC_STAT combineOperator(AOC_ACC *running, const AOC_ACC right);
 
 enum operator
 {
@@ -26,39 +23,49 @@ struct testCase
 	size_t val_len;
 };
 
-const struct 
+static const struct 
 {
 	const enum operator op; /* can be used as a check value */
-	const long int (*Callback)(const long int, const long int);
+	AOC_STAT (*Callback)(AOC_ACC *, const AOC_ACC);
 } operator_table[] =
 {
 	{AOC_MULTIPLY, multiplyOperator},
 	{AOC_ADD,      addOperator},
 	{AOC_COMBINE,  combineOperator}
 };
-const size_t operator_table_len 
+static const size_t operator_table_len 
 	= sizeof(operator_table) / sizeof(operator_table[0]);
 
-static long int addOperator(const long int left, const long int right)
+/* The operators fail rather than wrap when the result doesn't fit */
+static AOC_STAT addOperator(AOC_ACC *running, const AOC_ACC right)
 {
-	return left + right;
+	return accAdd(running, right);
 }
 
-static long int multiplyOperator(const long int left, const long int right)
+static AOC_STAT multiplyOperator(AOC_ACC *running, const AOC_ACC right)
 {
-	return left * right;
+	return accMul(running, right);
 }
 
-static long int combineOperator(const long int left, const long int right)
+static AOC_STAT combineOperator(AOC_ACC *running, const AOC_ACC right)
 {
-	size_t exp = 1;
+	AOC_ACC exp = 10;
+
+	while (right >= exp)
+	{
+		if (accMul(&exp, 10) != AOC_SUCCESS)
+		{
+			return AOC_FAILURE;
+		}
+	}
 
-	do
+	if ((accMul(running, exp) != AOC_SUCCESS)
+	|| (accAdd(running, right) != AOC_SUCCESS))
 	{
-		exp *= 10;
-	} while (right >= exp);
+		return AOC_FAILURE;
+	}
 
-	return (left * exp) + right;
+	return AOC_SUCCESS;
 }
 
 static void freeCases(struct testCase *case_arr, const size_t case_len)
@@ -76,20 +83,12 @@ static void freeCases(struct testCase *case_arr, const size_t case_len)
 	}
 }
 
-static long int extractValue(const char * const str)
-{
-	long int ret;
-
-	errno = 0;
-	ret = strtol(str, NULL, 0);
-	AOC_ASSERT(errno == 0);
-
-	return ret;
-}
-
-static AOC_STAT parseInput(FILE *input, struct testCase **out, size_t *out_len)
+static AOC_STAT parseInput(const struct aocView *input, struct testCase **out, 
+	size_t *out_len)
 {
-	char buffer[BUFFER_LEN] = {0};
+	const char *line = NULL;
+	size_t line_len;
+	size_t cursor = 0;
 	size_t out_max = 10;
 
 	if ((input == NULL) || (out == NULL))
@@ -99,40 +98,49 @@ static AOC_STAT parseInput(FILE *input, struct testCase **out, size_t *out_len)
 
 	AOC_NEW_DYN_ARR(struct testCase, *out, out_max);
 
-	while (fgets(buffer, BUFFER_LEN, input) != NULL)
+	while (viewNextLine(input, &cursor, &line, &line_len) == AOC_TRUE)
 	{
 		struct testCase tmp = {0};
-		char *token = NULL;
+		struct aocCursor curs;
+		long int tok_val;
 		size_t tmp_max = 5;
-		long int check_val;
-		int arg_start;
 
-		if (sscanf(buffer, "%ld: %n\n", &check_val, &arg_start) != 1)
-		{
-			fprintf(stderr, "Failed to parse line '%s'\n", buffer);
-
-			return AOC_FAILURE;
-		}
+		cursorInit(&curs, line, line_len);
 
-		tmp.check = check_val;
-
-		if ((token = strtok(buffer + arg_start, " ")) == NULL)
+		if ((scanLong(&curs, &tmp.check) != AOC_SUCCESS)
+		|| (scanExpect(&curs, ":") != AOC_SUCCESS))
 		{
-			fprintf(stderr, "No arguments given for line '%s'\n",
-				buffer);
+			fprintf(stderr, "Failed to parse line '%.*s'\n", 
+				(int) line_len, line);
 
 			return AOC_FAILURE;
 		}
 
 		AOC_NEW_DYN_ARR(long int, tmp.val_arr, tmp_max);
 
-		do
+		/* The arguments are walked in place rather than tokenized
+		 * out of a copy of the line */
+		for (;;)
 		{
-			const long int tok_val = extractValue(token);
+			scanSkipSpace(&curs);
+
+			if (scanLong(&curs, &tok_val) != AOC_SUCCESS)
+			{
+				break;
+			}
 
 			AOC_CAT_DYN_ARR(long int, tmp.val_arr, tmp.val_len,
 				tmp_max, tok_val);
-		} while ((token = strtok(NULL, " ")) != NULL);
+		}
+
+		if (tmp.val_len == 0)
+		{
+			fprintf(stderr, "No arguments given for line '%.*s'\n",
+				(int) line_len, line);
+			AOC_FREE(tmp.val_arr);
+
+			return AOC_FAILURE;
+		}
 
 		AOC_CAT_DYN_ARR(struct testCase, *out, *out_len, out_max, tmp);
 	}
@@ -141,7 +149,7 @@ static AOC_STAT parseInput(FILE *input, struct testCase **out, size_t *out_len)
 }
 
 static AOC_BOOL recursiveTest(const struct testCase test_case, 
-	const long int running, const size_t pos, const size_t num_ops)
+	const AOC_ACC running, const size_t pos, const size_t num_ops)
 {
 	size_t i;
 	AOC_BOOL ret = 0;
@@ -151,22 +159,29 @@ static AOC_BOOL recursiveTest(const struct testCase test_case,
 		return (running == test_case.check) ? AOC_TRUE : AOC_FALSE;
 	}
 
+	/* The values are never negative so a result too large for the 
+	 * accumulator is past the check and that branch can be dropped */
 	for (i = 0; i < num_ops; i++)
 	{
-		const long int tmp = operator_table[i].Callback(running, 
-			test_case.val_arr[pos]);
-		ret += recursiveTest(test_case, tmp, pos + 1, num_ops);
+		AOC_ACC tmp = running;
+
+		if (operator_table[i].Callback(&tmp, test_case.val_arr[pos])
+			== AOC_SUCCESS)
+		{
+			ret += recursiveTest(test_case, tmp, pos + 1, num_ops);
+		}
 	}
 	
 	return ret;
 }
 
-static long int sumValidReports(struct testCase *case_arr, 
-	const size_t case_len, const size_t operator_len)
+static AOC_STAT sumValidReports(struct testCase *case_arr, 
+	const size_t case_len, const size_t operator_len, AOC_ACC *total)
 {
-	long int total = 0;
 	size_t i;
 
+	*total = 0;
+
 	for (i = 0; i < case_len; i++)
 	{
 		int tmp = 0;
@@ -174,59 +189,80 @@ static long int sumValidReports(struct testCase *case_arr,
 		tmp += recursiveTest(case_arr[i], case_arr[i].val_arr[0], 1, 
 			operator_len);
 
-		if (tmp != 0)
+		if ((tmp != 0) 
+		&& (accAdd(total, case_arr[i].check) != AOC_SUCCESS))
 		{
-			total += case_arr[i].check;
+			return AOC_FAILURE;
 		}
 	}
 
-	return total;
+	return AOC_SUCCESS;
 }
 
-int main(int argc, char **argv)
+struct dayInput
 {
-	size_t i;
+	struct testCase *case_arr;
+	size_t case_len;
+};
 
-	AOC_ASSERT(operator_table_len == AOC_NUM_OPERATORS);
+static void dayFree(void *ctx)
+{
+	struct dayInput *in = ctx;
 
-	if (argc < 2)
+	if (in != NULL)
 	{
-		fputs("Please provive a file or files to act upon\n", stderr);
+		freeCases(in->case_arr, in->case_len);
+		AOC_FREE(in);
+	}
+}
 
-		return AOC_FAILURE;
+static void* dayParse(const struct aocView *input)
+{
+	struct dayInput *in = NULL;
+
+	AOC_ASSERT(operator_table_len == AOC_NUM_OPERATORS);
+
+	if ((in = calloc(1, sizeof(struct dayInput))) == NULL)
+	{
+		return NULL;
 	}
 
-	for (i = 1; i < argc; i++)
+	if (parseInput(input, &in->case_arr, &in->case_len) == AOC_FAILURE)
 	{
-		FILE *input = fopen(argv[i], "rb");
-		struct testCase *case_arr = NULL;
-		size_t case_len = 0;
+		dayFree(in);
 
-		if (input == NULL)
-		{
-			fprintf(stderr, "Cannot open file '%s'\n", argv[i]);
+		return NULL;
+	}
 
-			continue;
-		}
+	return in;
+}
 
-		if (parseInput(input, &case_arr, &case_len) == AOC_FAILURE)
-		{
-			fprintf(stderr, "Failed to parse file '%s'\n", 
-				argv[i]);
-			freeCases(case_arr, case_len);
-			fclose(input);
+static AOC_STAT dayPart1(void *ctx, AOC_ACC *answer)
+{
+	struct dayInput *in = ctx;
 
-			continue;
-		}
+	return sumValidReports(in->case_arr, in->case_len, 
+		AOC_NUM_OPERATORS - 1, answer);
+}
 
-		fprintf(stdout, "Part 1: %ld\n", sumValidReports(case_arr, 
-			case_len, AOC_NUM_OPERATORS - 1));
-		fprintf(stdout, "Part 2: %ld\n", sumValidReports(case_arr, 
-			case_len, AOC_NUM_OPERATORS));
-		freeCases(case_arr, case_len);
-		fclose(input);
-	}
+static AOC_STAT dayPart2(void *ctx, AOC_ACC *answer)
+{
+	struct dayInput *in = ctx;
 
-	return AOC_SUCCESS;
+	return sumValidReports(in->case_arr, in->case_len, 
+		AOC_NUM_OPERATORS, answer);
 }
 
+const struct aocDay aoc_day_07 =
+{
+	7, dayParse, dayPart1, dayPart2, dayFree,
+	"Part 1: %s\n",
+	"Part 2: %s\n"
+};
+
+#ifndef AOC_NO_MAIN
+int main(int argc, char **argv)
+{
+	return runDayMain(&aoc_day_07, argc, argv);
+}
+#endif /* AOC_NO_MAIN */
@@ -3,15 +3,6 @@
 
 #include "../aocCommon.h"
 
-#define BUFFER_LEN (1024)
-
-struct nodeMap
-{
-	char **data;
-	size_t rows;
-	size_t cols;
-};
-
 struct coordinate
 {
 	long int x_pos;
@@ -26,87 +17,61 @@ struct nodeIndex
 	size_t coords_max;
 };
 
-static int compareCoordinates(const void *foo, const void *bar)
-{
-	const struct coordinate * const left = (struct coordinate *) foo;
-	const struct coordinate * const right = (struct coordinate *) bar;
-
-	if (left->y_pos != right->y_pos)
-	{
-		return left->y_pos - right->y_pos;
-	}
-	else
-	{
-		return left->x_pos - right->x_pos;
-	}
-}
-
-static int compareNodeTypes(const void *foo, const void *bar)
-{
-	const struct nodeIndex * const left = (struct nodeIndex *) foo;
-	const struct nodeIndex * const right = (struct nodeIndex *) bar; 
-
-	return left->id - right->id;
-}
-
+/* The grid is scanned in row order so each node type's coordinates come out
+ * already sorted, the map only has to find the type's entry from its id */
 static size_t populateNodeIndex(struct nodeIndex **nodes, 
-	const struct nodeMap * const map)
+	const struct aocGrid * const map)
 {
+	struct aocHash types = {0};
 	size_t len = 0;
 	size_t max = 10;
 	size_t i, j;
 
 	AOC_NEW_DYN_ARR(struct nodeIndex, *nodes, max);
+	hashInit(&types, 0, AOC_TRUE);
 
 	for (j = 0; j < map->rows; j++)
 	{
 		for (i = 0; i < map->cols; i++)
 		{
-			const char marker = map->data[j][i];
+			const char marker = AOC_GRID_AT(map, i, j);
 			struct coordinate tmp_coord = {0};
-			struct nodeIndex tmp_type = {0};
 			struct nodeIndex *found = NULL;
+			size_t slot;
 
 			tmp_coord.x_pos = i;
 			tmp_coord.y_pos = j;
 
-			if (map->data[j][i] == '.')
+			if (marker == '.')
 			{
 				continue;
 			}
 
-			tmp_type.id = marker;
-
 			/* ID not already represented */
-			if ((found = bsearch(&tmp_type, *nodes, len, 
-				sizeof(struct nodeIndex), compareNodeTypes)) 
-					== NULL)
+			if (hashInsert(&types, AOC_HASH_KEY(marker), &slot) 
+				== AOC_TRUE)
 			{
-				/* Do operations on the new node type prior to
-				 * concatination! */
+				struct nodeIndex tmp_type = {0};
+
+				tmp_type.id = marker;
 				tmp_type.coords_len = 0;
 				tmp_type.coords_max = 10;
 				AOC_NEW_DYN_ARR(struct coordinate, 
 					tmp_type.coords, tmp_type.coords_max);
-				AOC_INSERT_CAT(struct coordinate, 
-					tmp_type.coords, tmp_type.coords_len, 
-					tmp_type.coords_max, tmp_coord, 
-					compareCoordinates);
-				AOC_INSERT_CAT(struct nodeIndex, *nodes, len, 
-					max, tmp_type, compareNodeTypes);
-			}
-			else
-			{
-				/* Concatinate just the new coordinate to the
-				 * existing header structure */
-				AOC_INSERT_CAT(struct coordinate, 
-					found->coords, found->coords_len, 
-					found->coords_max, tmp_coord, 
-					compareCoordinates);
+				types.vals[slot] = len;
+				AOC_CAT_DYN_ARR(struct nodeIndex, *nodes, len, 
+					max, tmp_type);
 			}
+
+			found = &(*nodes)[types.vals[slot]];
+			AOC_CAT_DYN_ARR(struct coordinate, found->coords, 
+				found->coords_len, found->coords_max, 
+				tmp_coord);
 		}
 	}
 
+	hashFree(&types);
+
 	return len;
 }
 
@@ -125,64 +90,8 @@ static void freeNodeIndex(struct nodeIndex *data, const size_t len)
 	}
 }
 
-static AOC_STAT parseInput(FILE *input, struct nodeMap *map)
-{
-	char buffer[BUFFER_LEN] = {0};
-	size_t len = 0;
-	size_t max = 10;
-	
-	if ((input == NULL) || (map == NULL))
-	{
-		return AOC_FAILURE;
-	}
-
-	AOC_NEW_DYN_ARR(char *, map->data, max);
-
-	while (fgets(buffer, BUFFER_LEN, input) != NULL)
-	{
-		/* No need for the newline character */
-		map->cols = strlen(buffer) - 1;
-
-		if (len == max)
-		{
-			AOC_GROW_DYN_ARR(char *, map->data, max);
-		}
-
-		/* Accomidate a null terminator to make printing simple */
-		if ((map->data[len] = malloc(sizeof(char) * (map->cols + 1))) 
-			== NULL)
-		{
-			return AOC_FAILURE;
-		}
-
-		memcpy(map->data[len], buffer, map->cols);
-		map->data[len][map->cols] = '\0';
-		len++;
-	}
-
-	map->rows = len;
-
-	return AOC_SUCCESS;
-}
-
-static void freeMap(struct nodeMap *map)
-{
-	if ((map != NULL)
-	&& (map->data != NULL))
-	{
-		size_t i;
-	
-		for (i = 0; i < map->rows; i++)
-		{
-			AOC_FREE(map->data[i]);
-		}
-
-		AOC_FREE(map->data);
-	}
-}
-
 static long int testAntinodePairs(const struct coordinate left, 
-	const struct coordinate right, struct nodeMap * const map)
+	const struct coordinate right, struct aocGrid * const map)
 {
 	int ret = 0;
 	struct coordinate diff = {0};
@@ -190,32 +99,30 @@ static long int testAntinodePairs(const struct coordinate left,
 	diff.x_pos = right.x_pos - left.x_pos;
 	diff.y_pos = right.y_pos - left.y_pos;
 
-	if ((left.x_pos - diff.x_pos >= 0)
-	&& (left.y_pos - diff.y_pos >= 0)
-	&& (left.x_pos - diff.x_pos < map->cols)
-	&& (left.y_pos - diff.y_pos < map->rows))
+	/* Antinodes can land arbitrarily far outside of the map so unlike
+	 * neighbour lookups these still need a real bounds check */
+	if (AOC_GRID_IN_BOUNDS(map, left.x_pos - diff.x_pos, 
+		left.y_pos - diff.y_pos))
 	{
-		const size_t anti_x = left.x_pos - diff.x_pos;
-		const size_t anti_y = left.y_pos - diff.y_pos;
+		const long int anti_x = left.x_pos - diff.x_pos;
+		const long int anti_y = left.y_pos - diff.y_pos;
 
-		if (map->data[anti_y][anti_x] != '#')
+		if (AOC_GRID_AT(map, anti_x, anti_y) != '#')
 		{
-			map->data[anti_y][anti_x] = '#';
+			AOC_GRID_AT(map, anti_x, anti_y) = '#';
 			ret++;
 		}
 	}
 
-	if ((diff.x_pos + right.x_pos >= 0)
-	&& (diff.y_pos + right.y_pos >= 0)
-	&& (diff.x_pos + right.x_pos < map->cols)
-	&& (diff.y_pos + right.y_pos < map->rows))
+	if (AOC_GRID_IN_BOUNDS(map, right.x_pos + diff.x_pos,
+		right.y_pos + diff.y_pos))
 	{
-		const size_t anti_x = right.x_pos + diff.x_pos;
-		const size_t anti_y = right.y_pos + diff.y_pos;
+		const long int anti_x = right.x_pos + diff.x_pos;
+		const long int anti_y = right.y_pos + diff.y_pos;
 
-		if (map->data[anti_y][anti_x] != '#')
+		if (AOC_GRID_AT(map, anti_x, anti_y) != '#')
 		{
-			map->data[anti_y][anti_x] = '#';
+			AOC_GRID_AT(map, anti_x, anti_y) = '#';
 			ret++;
 		}
 	}
@@ -223,13 +130,11 @@ static long int testAntinodePairs(const struct coordinate left,
 	return ret;
 }
 
-#define COORD_IN_BOUNDS(coord, map)                   \
-	(((coord).x_pos >= 0) && ((coord).y_pos >= 0) \
-		&& ((coord).x_pos < (map)->cols)      \
-		&& ((coord).y_pos < (map)->rows))
+#define COORD_IN_BOUNDS(coord, map) \
+	AOC_GRID_IN_BOUNDS((map), (coord).x_pos, (coord).y_pos)
 
 static long int testAntinodeRepeating(const struct coordinate left, 
-	const struct coordinate right, struct nodeMap *map)
+	const struct coordinate right, struct aocGrid *map)
 {
 	int ret = 0;
 	struct coordinate diff = {0};
@@ -241,9 +146,9 @@ static long int testAntinodeRepeating(const struct coordinate left,
 	
 	while (COORD_IN_BOUNDS(anti, map))
 	{
-		if (map->data[anti.y_pos][anti.x_pos] != '?')
+		if (AOC_GRID_AT(map, anti.x_pos, anti.y_pos) != '?')
 		{
-			map->data[anti.y_pos][anti.x_pos] = '?';
+			AOC_GRID_AT(map, anti.x_pos, anti.y_pos) = '?';
 			ret++;
 		}
 
@@ -255,9 +160,9 @@ static long int testAntinodeRepeating(const struct coordinate left,
 
 	while (COORD_IN_BOUNDS(anti, map))
 	{
-		if (map->data[anti.y_pos][anti.x_pos] != '?')
+		if (AOC_GRID_AT(map, anti.x_pos, anti.y_pos) != '?')
 		{
-			map->data[anti.y_pos][anti.x_pos] = '?';
+			AOC_GRID_AT(map, anti.x_pos, anti.y_pos) = '?';
 			ret++;
 		}
 
@@ -269,9 +174,9 @@ static long int testAntinodeRepeating(const struct coordinate left,
 }
 
 static size_t calculateAntinodes(const struct nodeIndex * const nodes,
-	const size_t num_nodes, struct nodeMap *map, 
+	const size_t num_nodes, struct aocGrid *map, 
 	long int (*Callback)(const struct coordinate, const struct coordinate,
-		struct nodeMap * const))
+		struct aocGrid * const))
 {
 	size_t i, j, k;
 	size_t antinodes = 0;
@@ -296,54 +201,76 @@ static size_t calculateAntinodes(const struct nodeIndex * const nodes,
 	return antinodes;
 }
 
-int main(int argc, char **argv)
+struct dayInput
 {
-	size_t i;
+	struct aocGrid map;
+	struct nodeIndex *nodes;
+	size_t num_nodes;
+};
 
-	if (argc < 2)
-	{
-		fputs("Please provide a file or files to act upon\n", stderr);
+static void* dayParse(const struct aocView *input)
+{
+	struct dayInput *in = NULL;
 
-		return AOC_FAILURE;
+	if ((in = malloc(sizeof(struct dayInput))) == NULL)
+	{
+		return NULL;
 	}
 
-	for (i = 1; i < argc; i++)
+	if (gridLoad(input, &in->map, 0, '\0') != AOC_SUCCESS)
 	{
-		FILE *input = fopen(argv[i], "rb");
-		struct nodeMap map = {0};
-		struct nodeIndex *nodes = NULL;
-		size_t num_nodes = 0;
+		AOC_FREE(in);
 
-		if (input == NULL)
-		{
-			fprintf(stderr, "Failed to open file '%s'\n", argv[i]);
+		return NULL;
+	}
 
-			continue;
-		}
+	in->num_nodes = populateNodeIndex(&in->nodes, &in->map);
 
-		if (parseInput(input, &map) != AOC_SUCCESS)
-		{
-			fprintf(stderr, "Failed to parse file '%s' to map\n", 
-				argv[i]);
-			freeMap(&map);
-			fclose(input);
+	return in;
+}
 
-			continue;
-		}
+static AOC_STAT dayPart1(void *ctx, AOC_ACC *answer)
+{
+	struct dayInput *in = ctx;
 
-		num_nodes = populateNodeIndex(&nodes, &map);
-		fprintf(stdout, "Part 1: %lu anti-nodes\n", 
-			calculateAntinodes(nodes, num_nodes, &map, 
-			testAntinodePairs));
-		fprintf(stdout, "Part 2: %lu anti-nodes\n", 
-			calculateAntinodes(nodes, num_nodes, &map, 
-			testAntinodeRepeating));
-
-		freeNodeIndex(nodes, num_nodes);
-		freeMap(&map);
-		fclose(input);
-	}
+	*answer = calculateAntinodes(in->nodes, in->num_nodes, &in->map, 
+		testAntinodePairs);
 
 	return AOC_SUCCESS;
 }
 
+static AOC_STAT dayPart2(void *ctx, AOC_ACC *answer)
+{
+	struct dayInput *in = ctx;
+
+	*answer = calculateAntinodes(in->nodes, in->num_nodes, &in->map, 
+		testAntinodeRepeating);
+
+	return AOC_SUCCESS;
+}
+
+static void dayFree(void *ctx)
+{
+	struct dayInput *in = ctx;
+
+	if (in != NULL)
+	{
+		freeNodeIndex(in->nodes, in->num_nodes);
+		gridFree(&in->map);
+		AOC_FREE(in);
+	}
+}
+
+const struct aocDay aoc_day_08 =
+{
+	8, dayParse, dayPart1, dayPart2, dayFree,
+	"Part 1: %s anti-nodes\n",
+	"Part 2: %s anti-nodes\n"
+};
+
+#ifndef AOC_NO_MAIN
+int main(int argc, char **argv)
+{
+	return runDayMain(&aoc_day_08, argc, argv);
+}
+#endif /* AOC_NO_MAIN */
@@ -35,30 +35,6 @@ static AOC_STAT dealBottom(struct deque *queue, int *out)
 	return (queue->b_index >= queue->f_index) ? AOC_SUCCESS : AOC_FAILURE;
 }
 
-static char* slurpInput(FILE *input, size_t *out_len)
-{
-	char *out_arr = NULL;
-	size_t len = 0;
-	size_t max = 10;
-	int ch;
-
-	if ((input == NULL) || (out_len == NULL))
-	{
-		return NULL;
-	}
-
-	AOC_NEW_DYN_ARR(char, out_arr, max);
-
-	while (((ch = fgetc(input)) != EOF) && (ch != '\n'))
-	{
-		AOC_CAT_DYN_ARR(char, out_arr, len, max, ch);
-	}
-
-	*out_len = len;
-
-	return out_arr;
-}
-
 static AOC_STAT parseBufferedInput(const char * const input, const size_t len, 
 	struct deque **out)
 {
@@ -105,11 +81,10 @@ static AOC_STAT parseBufferedInput(const char * const input, const size_t len,
 }
 
 /* Only works for part 1 */
-static size_t calculateChecksum(const char * const buffer, const size_t len, 
-	struct deque *queue)
+static AOC_STAT calculateChecksum(const char * const buffer, 
+	const size_t len, struct deque *queue, AOC_ACC *checksum)
 {
 	size_t pos = 0;
-	size_t checksum = 0;
 	AOC_BOOL active = AOC_TRUE;
 	size_t i;
 
@@ -118,6 +93,8 @@ static size_t calculateChecksum(const char * const buffer, const size_t len,
 		return AOC_FAILURE;
 	}
 
+	*checksum = 0;
+
 	for (i = 0; i < len; i++)
 	{
 		const size_t count = buffer[i] - '0';
@@ -125,6 +102,7 @@ static size_t calculateChecksum(const char * const buffer, const size_t len,
 
 		for (j = 0; j < count; j++)
 		{
+			AOC_ACC product = pos;
 			int file_id;
 
 			if (active == AOC_TRUE)
@@ -142,7 +120,12 @@ static size_t calculateChecksum(const char * const buffer, const size_t len,
 				}
 			}
 
-			checksum += (pos * file_id);
+			if ((accMul(&product, file_id) != AOC_SUCCESS)
+			|| (accAdd(checksum, product) != AOC_SUCCESS))
+			{
+				return AOC_FAILURE;
+			}
+
 			pos++;
 		}
 
@@ -155,7 +138,7 @@ static size_t calculateChecksum(const char * const buffer, const size_t len,
 		}
 	}
 
-	return checksum;
+	return AOC_SUCCESS;
 }
 
 static void freeDeque(struct deque *entries)
@@ -167,51 +150,74 @@ static void freeDeque(struct deque *entries)
 	}
 }
 
-int main(int argc, char **argv)
+struct dayInput
 {
-	size_t i;
+	const char *buffer;
+	size_t buffer_len;
+	struct deque *entries;
+};
 
-	if (argc < 2)
+static void* dayParse(const struct aocView *input)
+{
+	struct dayInput *in = NULL;
+	size_t cursor = 0;
+
+	if ((in = calloc(1, sizeof(struct dayInput))) == NULL)
 	{
-		fputs("Please provide an input file or files to act upon\n",
-			stderr);
+		return NULL;
+	}
 
-		return AOC_FAILURE;
+	/* The disk map is the first line of the input and is used in
+	 * place without copying it out of the view, an empty input is an
+	 * empty disk map */
+	if (viewNextLine(input, &cursor, &in->buffer, &in->buffer_len) 
+		== AOC_FALSE)
+	{
+		in->buffer = "";
+		in->buffer_len = 0;
 	}
 
-	for (i = 1; i < argc; i++)
+	if (parseBufferedInput(in->buffer, in->buffer_len, &in->entries) 
+		== AOC_FAILURE)
 	{
-		FILE *input;
-		char *buffer = NULL;
-		struct deque *entries = NULL;
-		size_t buffer_len;
+		freeDeque(in->entries);
+		AOC_FREE(in);
 
-		if ((input = fopen(argv[i], "rb")) == NULL)
-		{
-			fprintf(stderr, "Failed to open file '%s'\n", argv[i]);
+		return NULL;
+	}
 
-			continue;
-		}
+	return in;
+}
 
-		if (((buffer = slurpInput(input, &buffer_len)) == NULL)
-		|| (parseBufferedInput(buffer, buffer_len, &entries) 
-			== AOC_FAILURE))
-		{
-			fprintf(stderr, "Failed to parse file '%s'\n", 
-				argv[i]);
-			freeDeque(entries);
-			fclose(input);
+static AOC_STAT dayPart1(void *ctx, AOC_ACC *answer)
+{
+	struct dayInput *in = ctx;
 
-			continue;
-		}
+	return calculateChecksum(in->buffer, in->buffer_len, in->entries, 
+		answer);
+}
 
-		fprintf(stdout, "Part 1: %lu\n",
-			calculateChecksum(buffer, buffer_len, entries));
-		freeDeque(entries);
-		fclose(input);
-		AOC_FREE(buffer);
-	}
+static void dayFree(void *ctx)
+{
+	struct dayInput *in = ctx;
 
-	return AOC_SUCCESS;
+	if (in != NULL)
+	{
+		freeDeque(in->entries);
+		AOC_FREE(in);
+	}
 }
 
+const struct aocDay aoc_day_09 =
+{
+	9, dayParse, dayPart1, NULL, dayFree,
+	"Part 1: %s\n",
+	NULL
+};
+
+#ifndef AOC_NO_MAIN
+int main(int argc, char **argv)
+{
+	return runDayMain(&aoc_day_09, argc, argv);
+}
+#endif /* AOC_NO_MAIN */
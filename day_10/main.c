@@ -4,29 +4,17 @@
 
 #include "../aocCommon.h"
 
-#define BUFFER_LEN (1024)
-
-struct trailMap
-{
-	char **data;
-	size_t rows;
-	size_t cols;
-};
+/* Anything that isn't a digit works as the border, it can never be exactly
+ * one higher than the height of the current position */
+#define MAP_EDGE ('\0')
 
 struct coordinate
 {
-	size_t x_pos;
-	size_t y_pos;
+	long int x_pos;
+	long int y_pos;
 }; 
 
-struct visisted
-{
-	struct coordinate *coord;
-	size_t len;
-	size_t max;
-};
-
-const struct dirMap
+static const struct dirMap
 {
 	const int delta_x;
 	const int delta_y;
@@ -37,115 +25,28 @@ const struct dirMap
 	{0,  1}, /* SOUTH */
 	{-1, 0}  /* WEST */
 };
-const size_t dir_len = sizeof(dir_map) / sizeof(dir_map[0]);
-
-static int compareCoords(const void *foo, const void *bar)
-{
-	const struct coordinate * const left = (struct coordinate *) foo;
-	const struct coordinate * const right = (struct coordinate *) bar;
-
-	if (left->y_pos != right->y_pos)
-	{
-		return left->y_pos - right->y_pos;
-	}
-	else
-	{
-		return left->x_pos - right->x_pos;
-	}
-}
-
-static AOC_STAT slurpInput(FILE *input, struct trailMap **out)
-{
-	struct trailMap *map = malloc(sizeof(struct trailMap));
-	char buffer[BUFFER_LEN] = {0};
-	size_t len = 0;
-	size_t max = 10;
-	
-	if ((input == NULL) || (map == NULL))
-	{
-		return AOC_FAILURE;
-	}
-
-	AOC_NEW_DYN_ARR(char *, map->data, max);
-
-	while (fgets(buffer, BUFFER_LEN, input) != NULL)
-	{
-		/* No need for the newline character */
-		map->cols = strlen(buffer) - 1;
-
-		if (len == max)
-		{
-			AOC_GROW_DYN_ARR(char *, map->data, max);
-		}
-
-		/* Accomidate a null terminator to make printing simple */
-		if ((map->data[len] = malloc(sizeof(char) * (map->cols + 1))) 
-			== NULL)
-		{
-			return AOC_FAILURE;
-		}
-
-		memcpy(map->data[len], buffer, map->cols);
-		map->data[len][map->cols] = '\0';
-		len++;
-	}
-
-	map->rows = len;
-	*out = map;
-
-	return AOC_SUCCESS;
-}
-
-static void freeMap(struct trailMap *map)
-{
-	if (map != NULL)
-	{
-		size_t i;
-		
-		for (i = 0; i < map->rows; i++)
-		{
-			AOC_FREE(map->data[i]);
-		}
+static const size_t dir_len = sizeof(dir_map) / sizeof(dir_map[0]);
 
-		AOC_FREE(map->data);
-		AOC_FREE(map);
-	}
-}
-
-static long int testTrails(const struct trailMap * const map, 
-	const size_t x_pos, const size_t y_pos, struct visisted *nines)
+static long int testTrails(const struct aocGrid * const map, 
+	const long int x_pos, const long int y_pos, struct aocHash *nines)
 {
 	size_t i, ret = 0;
 
-	if (map->data[y_pos][x_pos] == '9')
+	if (AOC_GRID_AT(map, x_pos, y_pos) == '9')
 	{
-		struct coordinate key = {0};
-		struct coordinate *found = NULL;
-
-		key.x_pos = x_pos;
-		key.y_pos = y_pos;
-
-		if ((found = bsearch(&key, nines->coord, nines->len, 
-			sizeof(struct coordinate), compareCoords)) != NULL)
-		{
-			/* Already visisted */
-			return 0;
-		}
-
-		AOC_INSERT_CAT(struct coordinate, nines->coord, nines->len,
-			nines->max, key, compareCoords);
-
-		return 1;
+		/* Zero when already visisted */
+		return hashInsert(nines, 
+			AOC_HASH_KEY(AOC_GRID_OFFSET(map, x_pos, y_pos)), NULL)
+			== AOC_TRUE;
 	}
 
 	for (i = 0; i < dir_len; i++)
 	{
-		const size_t new_x = x_pos + dir_map[i].delta_x;
-		const size_t new_y = y_pos + dir_map[i].delta_y;
+		const long int new_x = x_pos + dir_map[i].delta_x;
+		const long int new_y = y_pos + dir_map[i].delta_y;
 
-		/* Relying on unsigned underflow */
-		if (((new_x < map->cols) && (new_y < map->rows))
-		&& (map->data[new_y][new_x] - map->data[y_pos][x_pos] == 1))
+		if (AOC_GRID_AT(map, new_x, new_y) 
+			- AOC_GRID_AT(map, x_pos, y_pos) == 1)
 		{
 			ret += testTrails(map, new_x, new_y, nines);
 		}
@@ -156,9 +57,9 @@ static long int testTrails(const struct trailMap * const map,
 
 /* Counting just how many unique nines a given zero position can reach, doesn't
  * care if there are two ways to get to the same nine */
-static long int getTrailScores(struct trailMap *map)
+static long int getTrailScores(const struct aocGrid * const map)
 {
-	struct visisted nines = {0};
+	struct aocHash nines = {0};
 	long int score = 0;
 	size_t i, j;
 
@@ -167,45 +68,44 @@ static long int getTrailScores(struct trailMap *map)
 		return -1;
 	}
 
-	AOC_NEW_DYN_ARR(struct coordinate, nines.coord, nines.max);
+	hashInit(&nines, 0, AOC_FALSE);
 
 	for (j = 0; j < map->rows; j++)
 	{
 		for (i = 0; i < map->cols; i++)
 		{
-			if (map->data[j][i] == '0')
+			if (AOC_GRID_AT(map, i, j) == '0')
 			{
 				score += testTrails(map, i, j, &nines);
 
 				/* Reset the visisted positions */
-				nines.len = 0;
+				hashClear(&nines);
 			}
 		}
 	}
 
-	AOC_FREE(nines.coord);
+	hashFree(&nines);
 
 	return score;
 }
 
-static long int testRatings(const struct trailMap * const map, 
-	const size_t x_pos, const size_t y_pos)
+static long int testRatings(const struct aocGrid * const map, 
+	const long int x_pos, const long int y_pos)
 {
 	size_t i, ret = 0;
 
-	if (map->data[y_pos][x_pos] == '9')
+	if (AOC_GRID_AT(map, x_pos, y_pos) == '9')
 	{
 		return 1;
 	}
 
 	for (i = 0; i < dir_len; i++)
 	{
-		const size_t new_x = x_pos + dir_map[i].delta_x;
-		const size_t new_y = y_pos + dir_map[i].delta_y;
+		const long int new_x = x_pos + dir_map[i].delta_x;
+		const long int new_y = y_pos + dir_map[i].delta_y;
 
-		/* Relying on unsigned underflow */
-		if (((new_x < map->cols) && (new_y < map->rows))
-		&& (map->data[new_y][new_x] - map->data[y_pos][x_pos] == 1))
+		if (AOC_GRID_AT(map, new_x, new_y) 
+			- AOC_GRID_AT(map, x_pos, y_pos) == 1)
 		{
 			ret += testRatings(map, new_x, new_y);
 		}
@@ -216,7 +116,7 @@ static long int testRatings(const struct trailMap * const map,
 
 /* Like part 1 but now multiple ways to get to the same nine can be counted 
  * in the 'rating' of a trail */
-static long int getTrailRatings(struct trailMap *map)
+static long int getTrailRatings(const struct aocGrid * const map)
 {
 	long int score = 0;
 	size_t i, j;
@@ -230,7 +130,7 @@ static long int getTrailRatings(struct trailMap *map)
 	{
 		for (i = 0; i < map->cols; i++)
 		{
-			if (map->data[j][i] == '0')
+			if (AOC_GRID_AT(map, i, j) == '0')
 			{
 				score += testRatings(map, i, j);
 			}
@@ -240,47 +140,60 @@ static long int getTrailRatings(struct trailMap *map)
 	return score;
 }
 
-int main(int argc, char **argv)
+static void* dayParse(const struct aocView *input)
 {
-	size_t i;
+	struct aocGrid *map = NULL;
 
-	if (argc < 2)
+	if ((map = malloc(sizeof(struct aocGrid))) == NULL)
 	{
-		fputs("Please provide an input file or files to act upon\n",
-			stderr);
-
-		return AOC_FAILURE;
+		return NULL;
 	}
 
-	for (i = 1; i < argc; i++)
+	if (gridLoad(input, map, 1, MAP_EDGE) != AOC_SUCCESS)
 	{
-		FILE *input;
-		struct trailMap *map = NULL;
+		AOC_FREE(map);
 
-		if ((input = fopen(argv[i], "rb")) == NULL)
-		{
-			fprintf(stderr, "Failed to open '%s' for input\n",
-				argv[i]);
+		return NULL;
+	}
 
-			continue;
-		}
+	return map;
+}
 
-		if (slurpInput(input, &map) != AOC_SUCCESS)
-		{
-			fprintf(stderr, "Failed to parse '%s' to map\n",
-				argv[i]);
-			fclose(input);
-			freeMap(map);
+static AOC_STAT dayPart1(void *ctx, AOC_ACC *answer)
+{
+	*answer = getTrailScores(ctx);
 
-			continue;
-		}
+	return AOC_SUCCESS;
+}
 
-		fprintf(stdout, "Part 1: %ld\n", getTrailScores(map));
-		fprintf(stdout, "Part 2: %ld\n", getTrailRatings(map));
-		fclose(input);
-		freeMap(map);
-	}
+static AOC_STAT dayPart2(void *ctx, AOC_ACC *answer)
+{
+	*answer = getTrailRatings(ctx);
 
 	return AOC_SUCCESS;
 }
 
+static void dayFree(void *ctx)
+{
+	struct aocGrid *map = ctx;
+
+	if (map != NULL)
+	{
+		gridFree(map);
+		AOC_FREE(map);
+	}
+}
+
+const struct aocDay aoc_day_10 =
+{
+	10, dayParse, dayPart1, dayPart2, dayFree,
+	"Part 1: %s\n",
+	"Part 2: %s\n"
+};
+
+#ifndef AOC_NO_MAIN
+int main(int argc, char **argv)
+{
+	return runDayMain(&aoc_day_10, argc, argv);
+}
+#endif /* AOC_NO_MAIN */
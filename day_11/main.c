@@ -60,9 +60,9 @@ static unsigned int numDigits(const long int input)
 
 /* The obvious solution, works fine for smallish number of steps but is 
  * wholely inadequate for part 2 */
-static long int getStoneValue(const long int val, const int step)
+static AOC_ACC getStoneValue(const long int val, const int step)
 {
-	long int ret = 0;
+	AOC_ACC ret = 0;
 	unsigned int digits = 0;
 
 	if (step == 0)
@@ -99,13 +99,14 @@ static long int getStoneValue(const long int val, const int step)
 
 /* One possibly use calculate the number of stones here directly from the 
  * parsed running values without pushing them to an array */
-static AOC_STAT parseInput(FILE *input, int **out, size_t *out_len)
+static AOC_STAT parseInput(const struct aocView *input, int **out, 
+	size_t *out_len)
 {
 	int *working = NULL;
 	size_t len = 0;
 	size_t max = 10;
+	size_t i;
 	int running = 0;
-	int ch;
 	AOC_BOOL active = AOC_FALSE;
 
 	if ((input == NULL) || (out == NULL) || (out_len == NULL))
@@ -115,8 +116,10 @@ static AOC_STAT parseInput(FILE *input, int **out, size_t *out_len)
 
 	AOC_NEW_DYN_ARR(int, working, max);
 
-	while ((ch = fgetc(input)) != EOF)
+	for (i = 0; i < input->len; i++)
 	{
+		const char ch = input->data[i];
+
 		if ((ch >= '0') && (ch <= '9'))
 		{
 			running *= 10;
@@ -160,66 +163,82 @@ static void dumpArray(const int * const array, const size_t len)
 	fputc('\n', stdout);
 }
 
-static size_t obviousSolution(const int * const array, const size_t len, 
-	const size_t steps)
+/* A stone can at most double each step so its own count only overflows past
+ * the accumulator's width in steps, the total across stones is checked */
+static AOC_STAT obviousSolution(const int * const array, const size_t len, 
+	const size_t steps, AOC_ACC *stones)
 {
-	size_t i, stones = 0;
+	size_t i;
+
+	*stones = 0;
 
 	for (i = 0; i < len; i++)
 	{
-		stones += getStoneValue(array[i], steps);	
+		if (accAdd(stones, getStoneValue(array[i], steps)) 
+			!= AOC_SUCCESS)
+		{
+			return AOC_FAILURE;
+		}
 	}
 
-	return stones;
+	return AOC_SUCCESS;
 }
 
-int main(int argc, char **argv)
+struct dayInput
 {
-	size_t i;
+	int *vals;
+	size_t val_len;
+};
 
-	if (argc < 2)
-	{
-		fputs("Please provide an input file or files to act upon\n",
-			stderr);
+static void dayFree(void *ctx)
+{
+	struct dayInput *in = ctx;
 
-		return AOC_FAILURE;
+	if (in != NULL)
+	{
+		AOC_FREE(in->vals);
+		AOC_FREE(in);
 	}
+}
 
-	for (i = 1; i < argc; i++)
-	{
-		FILE *input = NULL;
-		int *vals = NULL;
-		size_t val_len = 0;
+static void* dayParse(const struct aocView *input)
+{
+	struct dayInput *in = NULL;
 
-		if ((input = fopen(argv[i], "rb")) == NULL)
-		{
-			fprintf(stderr, "Failed to open file '%s'\n", argv[i]);
+	if ((in = calloc(1, sizeof(struct dayInput))) == NULL)
+	{
+		return NULL;
+	}
 
-			continue;
-		}
+	if (parseInput(input, &in->vals, &in->val_len) == AOC_FAILURE)
+	{
+		dayFree(in);
 
-		if (parseInput(input, &vals, &val_len) == AOC_FAILURE)
-		{
-			fprintf(stderr, "Failed to parse file '%s'\n", 
-				argv[i]);
+		return NULL;
+	}
 
-			fclose(input);
-			AOC_FREE(vals);
+	return in;
+}
 
-			continue;
-		}
+static AOC_STAT dayPart1(void *ctx, AOC_ACC *answer)
+{
+	const struct dayInput *in = ctx;
 
-		fprintf(stdout, "Part 1: %ld stones\n", 
-			obviousSolution(vals, val_len, 25));
-		/*
-		fprintf(stdout, "Part 2: %ld stones\n", 
-			obviousSolution(vals, val_len, 75));
-		*/
+	return obviousSolution(in->vals, in->val_len, 25, answer);
+}
 
-		fclose(input);
-		AOC_FREE(vals);
-	}
+/* The obvious solution doesn't scale to the 75 steps of part 2 so it is left
+ * unsolved for now */
+const struct aocDay aoc_day_11 =
+{
+	11, dayParse, dayPart1, NULL, dayFree,
+	"Part 1: %s stones\n",
+	NULL
+};
 
-	return AOC_SUCCESS;
+#ifndef AOC_NO_MAIN
+int main(int argc, char **argv)
+{
+	return runDayMain(&aoc_day_11, argc, argv);
 }
-
+#endif /* AOC_NO_MAIN */
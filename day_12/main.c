@@ -4,8 +4,6 @@
 
 #include "../aocCommon.h"
 
-#define BUFFER_LEN (1024)
-
 /* This big trick here is finding the area and perimeter of a region in a grid,
  * there is no requirement that the region be a rectangle */
 
@@ -16,14 +14,11 @@
  * One would then need to also mark the visited tile somehow to avoid counting
  * the region more than once */
 
-struct gardenMap
-{
-	signed char **data;
-	size_t cols;
-	size_t rows;
-};
+/* Plots are read as signed characters so that finished ones can be marked by
+ * negating them, the zero border around the map never matches any plant */
+#define GARDEN_AT(map, x, y) (*(signed char *) &AOC_GRID_AT((map), (x), (y)))
 
-const struct coordinate
+static const struct coordinate
 {
 	long int x_pos;
 	long int y_pos;
@@ -34,87 +29,14 @@ const struct coordinate
 	{0,  1}, /* SOUTH */
 	{-1, 0}  /* WEST */
 };
-const size_t dir_map_len = sizeof(dir_map) / sizeof(dir_map[0]);
-
-static int compareCoordinates(const void *foo, const void *bar)
-{
-	const struct coordinate * const left = (struct coordinate *) foo;
-	const struct coordinate * const right = (struct coordinate *) bar;
-
-	if (left->y_pos != right->y_pos)
-	{
-		return left->y_pos - right->y_pos;
-	}
-	else
-	{
-		return left->x_pos - right->x_pos;
-	}
-}
-
-static AOC_STAT parseInput(FILE *input, struct gardenMap *map)
-{
-	char buffer[BUFFER_LEN] = {0};
-	size_t len = 0;
-	size_t max = 10;
-	
-	if ((input == NULL) || (map == NULL))
-	{
-		return AOC_FAILURE;
-	}
-
-	AOC_NEW_DYN_ARR(signed char *, map->data, max);
-
-	while (fgets(buffer, BUFFER_LEN, input) != NULL)
-	{
-		/* No need for the newline character */
-		map->cols = strlen(buffer) - 1;
-
-		if (len == max)
-		{
-			AOC_GROW_DYN_ARR(signed char *, map->data, max);
-		}
-
-		/* Accomidate a null terminator to make printing simple */
-		if ((map->data[len] = malloc(
-			sizeof(signed char) * (map->cols + 1))) == NULL)
-		{
-			return AOC_FAILURE;
-		}
-
-		memcpy(map->data[len], buffer, map->cols);
-		map->data[len][map->cols] = '\0';
-		len++;
-	}
-
-	map->rows = len;
-
-	return AOC_SUCCESS;
-}
-
-static void freeMap(struct gardenMap *map)
-{
-	if ((map != NULL)
-	&& (map->data != NULL))
-	{
-		size_t i;
-	
-		for (i = 0; i < map->rows; i++)
-		{
-			AOC_FREE(map->data[i]);
-		}
-
-		AOC_FREE(map->data);
-	}
-}
+static const size_t dir_map_len = sizeof(dir_map) / sizeof(dir_map[0]);
 
 struct floodInfo
 {
 	char symbol;
 	size_t area;
 	size_t peri;
-	struct coordinate *visited;
-	size_t visit_len;
-	size_t visit_max;
+	struct aocHash visited;
 };
 
 static struct floodInfo* prepareInfo(struct floodInfo *info, const char symbol)
@@ -124,17 +46,15 @@ static struct floodInfo* prepareInfo(struct floodInfo *info, const char symbol)
 		return NULL;
 	}
 
-	if (info->visited == NULL)
+	if (info->visited.keys == NULL)
 	{
-		info->visit_max = 10;
-		AOC_NEW_DYN_ARR(struct coordinate, info->visited, 
-			info->visit_max);
+		hashInit(&info->visited, 0, AOC_FALSE);
 	}
 
 	info->symbol = symbol;
 	info->area = 0;
 	info->peri = 0;
-	info->visit_len = 0;
+	hashClear(&info->visited);
 
 	return info;
 }
@@ -143,35 +63,22 @@ static struct floodInfo* prepareInfo(struct floodInfo *info, const char symbol)
 #define MARK_POS_FINISHED(pos) ((pos) * (-1))
 #define IS_POS_FINISHED(pos) ((pos) < 0)
 
-static void floodFind(struct gardenMap * const map, const size_t y_pos,
-	const size_t x_pos, struct floodInfo *info)
+static void floodFind(struct aocGrid * const map, const long int y_pos,
+	const long int x_pos, struct floodInfo *info)
 {
 	size_t i;
-	struct coordinate key = {0};
-	struct coordinate *found = NULL;
+	const AOC_BOOL is_new = hashInsert(&info->visited, 
+		AOC_HASH_KEY(AOC_GRID_OFFSET(map, x_pos, y_pos)), NULL);
 
-	key.x_pos = (long int) x_pos;
-	key.y_pos = (long int) y_pos;
-
-	if ((found = bsearch(&key, info->visited, info->visit_len,
-		sizeof(struct coordinate), compareCoordinates)) == NULL)
-	{
-		AOC_INSERT_CAT(struct coordinate, info->visited, 
-			info->visit_len, info->visit_max, key, 
-			compareCoordinates);
-	}
-
-	if ((y_pos >= map->cols) 
-	|| (x_pos >= map->rows)
-	|| (POS_AS_CHAR(map->data[y_pos][x_pos]) != info->symbol))
+	if (POS_AS_CHAR(GARDEN_AT(map, x_pos, y_pos)) != info->symbol)
 	{
 		info->peri++;
 	}
-	else if (found == NULL)
+	else if (is_new == AOC_TRUE)
 	{
 		info->area++;
-		map->data[y_pos][x_pos] 
-			= MARK_POS_FINISHED(map->data[y_pos][x_pos]);
+		GARDEN_AT(map, x_pos, y_pos) 
+			= MARK_POS_FINISHED(GARDEN_AT(map, x_pos, y_pos));
 
 		for (i = 0; i < dir_map_len; i++)
 		{
@@ -181,33 +88,48 @@ static void floodFind(struct gardenMap * const map, const size_t y_pos,
 	}
 }
 
-static void dumpMap(const struct gardenMap * const map);
+static void dumpMap(const struct aocGrid * const map);
 
-static long int calculateCostPartI(struct gardenMap * const map)
+static AOC_STAT calculateCostPartI(struct aocGrid * const map, 
+	AOC_ACC *total_cost)
 {
 	struct floodInfo info = {0};
+	AOC_STAT ret = AOC_SUCCESS;
 	size_t i, j;
-	long int total_cost = 0;
 
-	for (j = 0; j < map->rows; j++)
+	*total_cost = 0;
+
+	for (j = 0; (j < map->rows) && (ret == AOC_SUCCESS); j++)
 	{
 		for (i = 0; i < map->cols; i++)
 		{
-			const char symbol = map->data[j][i];
+			const char symbol = GARDEN_AT(map, i, j);
+			AOC_ACC cost;
 
-			if (IS_POS_FINISHED(map->data[j][i]))
+			if (IS_POS_FINISHED(GARDEN_AT(map, i, j)))
 			{
 				continue;
 			}
 
+			AOC_TRACE_BEGIN("floodFind");
 			floodFind(map, j, i, prepareInfo(&info, symbol));
-			total_cost += (info.area * info.peri);
+			AOC_TRACE_END("floodFind");
+			AOC_TRACE_COUNTER("region area", info.area);
+			cost = info.area;
+
+			if ((accMul(&cost, info.peri) != AOC_SUCCESS)
+			|| (accAdd(total_cost, cost) != AOC_SUCCESS))
+			{
+				ret = AOC_FAILURE;
+
+				break;
+			}
 		}
 	}
 
-	AOC_FREE(info.visited);
+	hashFree(&info.visited);
 
-	return total_cost;
+	return ret;
 }
 
 /* Now counting the number of sides instead of the number of individual units 
@@ -217,12 +139,12 @@ static long int calculateCostPartI(struct gardenMap * const map)
  * with the flood algorithm and when an adjacent portion is encountered that
  * does not match the currently symbol one could try to follow that edge 
  * until that direction of adjacency is broken, marking the entire time */
-static long int calculateCostPartII(struct gardenMap * const map)
+static AOC_ACC calculateCostPartII(struct aocGrid * const map)
 {
 	return 0;
 }
 
-static void dumpMap(const struct gardenMap * const map)
+static void dumpMap(const struct aocGrid * const map)
 {
 	if (map != NULL)
 	{
@@ -232,9 +154,9 @@ static void dumpMap(const struct gardenMap * const map)
 		{
 			for (j = 0; j < map->cols; j++)
 			{
-				const char tmp = (map->data[i][j] < 0)
+				const char tmp = (GARDEN_AT(map, j, i) < 0)
 					? '.'
-					: POS_AS_CHAR(map->data[i][j]);
+					: POS_AS_CHAR(GARDEN_AT(map, j, i));
 
 				fputc(tmp, stdout);
 			}
@@ -244,45 +166,58 @@ static void dumpMap(const struct gardenMap * const map)
 	}
 }
 
-int main(int argc, char **argv)
+static void* dayParse(const struct aocView *input)
 {
-	size_t i;
+	struct aocGrid *map = NULL;
 
-	if (argc < 2)
+	if ((map = malloc(sizeof(struct aocGrid))) == NULL)
 	{
-		fputs("Please provide a file or files to act upon\n", stderr);
-
-		return AOC_FAILURE;
+		return NULL;
 	}
 
-	for (i = 1; i < argc; i++)
+	if (gridLoad(input, map, 1, '\0') != AOC_SUCCESS)
 	{
-		FILE *input = fopen(argv[i], "rb");
-		struct gardenMap map = {0};
-
-		if (input == NULL)
-		{
-			fprintf(stderr, "Failure to open '%s' for input\n",
-				argv[i]);
+		AOC_FREE(map);
 
-			continue;
-		}
+		return NULL;
+	}
 
-		if (parseInput(input, &map) == AOC_FAILURE)
-		{
-			fprintf(stderr, "Failed to parse input file '%s'\n",
-				argv[i]);
-			fclose(input);
+	return map;
+}
 
-			continue;
-		}
+static AOC_STAT dayPart1(void *ctx, AOC_ACC *answer)
+{
+	return calculateCostPartI(ctx, answer);
+}
 
-		fprintf(stdout, "Part 1: %ld\n", calculateCostPartI(&map));
-		fprintf(stdout, "Part 2: %ld\n", calculateCostPartII(&map));
-		fclose(input);
-		freeMap(&map);
-	}
+static AOC_STAT dayPart2(void *ctx, AOC_ACC *answer)
+{
+	*answer = calculateCostPartII(ctx);
 
 	return AOC_SUCCESS;
 }
 
+static void dayFree(void *ctx)
+{
+	struct aocGrid *map = ctx;
+
+	if (map != NULL)
+	{
+		gridFree(map);
+		AOC_FREE(map);
+	}
+}
+
+const struct aocDay aoc_day_12 =
+{
+	12, dayParse, dayPart1, dayPart2, dayFree,
+	"Part 1: %s\n",
+	"Part 2: %s\n"
+};
+
+#ifndef AOC_NO_MAIN
+int main(int argc, char **argv)
+{
+	return runDayMain(&aoc_day_12, argc, argv);
+}
+#endif /* AOC_NO_MAIN */
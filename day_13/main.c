@@ -17,30 +17,37 @@ struct entry
 	struct coordinate prize;
 };
 
-/* Normally sscanf is a safer choice than fscanf, but for expediency I will
- * use the latter here. */
-static AOC_STAT parseFile(FILE *input, struct entry **out, size_t *out_len)
+static AOC_STAT parseFile(const struct aocView *input, struct entry **out, 
+	size_t *out_len)
 {
-	const char format_str[] = "Button A: X+%ld, Y+%ld\n"
-		"Button B: X+%ld, Y+%ld\n"
-		"Prize: X=%ld, Y=%ld\n";
+	struct aocCursor curs;
 	struct entry tmp = {0};
 	struct entry *working = NULL;
 	size_t len = 0;
-	size_t max = 10;
-	int num_parsed = 0;
+	size_t max = 0;
 
 	if ((input == NULL) || (out == NULL) || (out_len == NULL))
 	{
 		return AOC_FAILURE;
 	}
 
-	AOC_NEW_DYN_ARR(struct entry, working, max);
-
-	while ((num_parsed = fscanf(input, format_str, 
-		&tmp.a_button.x, &tmp.a_button.y, 
-		&tmp.b_button.x, &tmp.b_button.y, 
-		&tmp.prize.x, &tmp.prize.y)) == 6)
+	/* Three lines per machine and a blank one between each */
+	AOC_RESERVE_DYN_ARR(struct entry, working, max,
+		(viewEstimateLines(input, 0, input->len) / 4) + 1);
+	cursorInit(&curs, input->data, input->len);
+
+	while ((scanLabeledLong(&curs, "Button A: X+", &tmp.a_button.x)
+		== AOC_SUCCESS)
+	&& (scanLabeledLong(&curs, ", Y+", &tmp.a_button.y)
+		== AOC_SUCCESS)
+	&& (scanLabeledLong(&curs, "Button B: X+", &tmp.b_button.x)
+		== AOC_SUCCESS)
+	&& (scanLabeledLong(&curs, ", Y+", &tmp.b_button.y)
+		== AOC_SUCCESS)
+	&& (scanLabeledLong(&curs, "Prize: X=", &tmp.prize.x)
+		== AOC_SUCCESS)
+	&& (scanLabeledLong(&curs, ", Y=", &tmp.prize.y)
+		== AOC_SUCCESS))
 	{
 		AOC_CAT_DYN_ARR(struct entry, working, len, max, tmp);
 	}
@@ -51,100 +58,157 @@ static AOC_STAT parseFile(FILE *input, struct entry **out, size_t *out_len)
 	return AOC_SUCCESS;
 }
 
-/* The coordinate type for 'out' is being used for convenience with the 
- * understanding that x is 'A' presses and y is 'B' presses */
-static AOC_BOOL cramersRule(const struct coordinate button_a, 
-	const struct coordinate button_b, const struct coordinate prize,
-	struct coordinate *out)
+/* left_x * right_y - left_y * right_x */
+static AOC_STAT crossProduct(const AOC_ACC left_x, const AOC_ACC left_y,
+	const AOC_ACC right_x, const AOC_ACC right_y, AOC_ACC *out)
 {
-	const long int denominator 
-		= (button_a.x * button_b.y - button_a.y * button_b.x);
-	const long int numerator_a 
-		= ((prize.x * button_b.y) - (prize.y * button_b.x));
-	const long int numerator_b 
-		= ((prize.y * button_a.x) - (prize.x * button_a.y));
-	
-	if ((numerator_a % denominator == 0)
-	&& (numerator_b % denominator == 0))
-	{
-		out->x = numerator_a / denominator;
-		out->y = numerator_b / denominator;
+	AOC_ACC foo = left_x;
+	AOC_ACC bar = left_y;
 
-		return AOC_SUCCESS;
+	if ((accMul(&foo, right_y) != AOC_SUCCESS)
+	|| (accMul(&bar, right_x) != AOC_SUCCESS)
+	|| (accSub(&foo, bar) != AOC_SUCCESS))
+	{
+		return AOC_FAILURE;
 	}
-	else
+
+	*out = foo;
+
+	return AOC_SUCCESS;
+}
+
+/* Sets the presses of each button if the prize can be reached in whole 
+ * presses, only fails when the products don't fit in the accumulator. Buttons
+ * that move along the same line have no single solution and are skipped */
+static AOC_STAT cramersRule(const struct coordinate button_a, 
+	const struct coordinate button_b, const AOC_ACC prize_x, 
+	const AOC_ACC prize_y, AOC_ACC *presses_a, AOC_ACC *presses_b,
+	AOC_BOOL *is_solvable)
+{
+	AOC_ACC denominator, numerator_a, numerator_b;
+
+	*is_solvable = AOC_FALSE;
+
+	if ((crossProduct(button_a.x, button_a.y, button_b.x, button_b.y,
+		&denominator) != AOC_SUCCESS)
+	|| (crossProduct(prize_x, prize_y, button_b.x, button_b.y, 
+		&numerator_a) != AOC_SUCCESS)
+	|| (crossProduct(button_a.x, button_a.y, prize_x, prize_y, 
+		&numerator_b) != AOC_SUCCESS))
 	{
 		return AOC_FAILURE;
 	}
+	
+	if ((denominator != 0)
+	&& (numerator_a % denominator == 0)
+	&& (numerator_b % denominator == 0))
+	{
+		*presses_a = numerator_a / denominator;
+		*presses_b = numerator_b / denominator;
+		*is_solvable = AOC_TRUE;
+	}
+
+	return AOC_SUCCESS;
 }
 
-static long int getTotalCoins(const struct entry * const arr, 
-	const size_t len, const long int offset)
+static AOC_STAT getTotalCoins(const struct entry * const arr, 
+	const size_t len, const AOC_ACC offset, AOC_ACC *total)
 {
-	long int total = 0;
 	size_t i;
 
+	*total = 0;
+
 	for (i = 0; i < len; i++)
 	{
-		struct coordinate prize = arr[i].prize;
-		struct coordinate tmp = {0};
-
-		prize.x += offset;
-		prize.y += offset;
+		AOC_ACC prize_x = arr[i].prize.x;
+		AOC_ACC prize_y = arr[i].prize.y;
+		AOC_ACC presses_a, presses_b;
+		AOC_BOOL is_solvable;
+
+		if ((accAdd(&prize_x, offset) != AOC_SUCCESS)
+		|| (accAdd(&prize_y, offset) != AOC_SUCCESS)
+		|| (cramersRule(arr[i].a_button, arr[i].b_button, prize_x,
+			prize_y, &presses_a, &presses_b, &is_solvable) 
+			!= AOC_SUCCESS))
+		{
+			return AOC_FAILURE;
+		}
 
-		if (cramersRule(arr[i].a_button, arr[i].b_button, prize, &tmp) 
-			== AOC_SUCCESS)
+		if ((is_solvable == AOC_TRUE)
+		&& ((accMul(&presses_a, 3) != AOC_SUCCESS)
+			|| (accAdd(&presses_a, presses_b) != AOC_SUCCESS)
+			|| (accAdd(total, presses_a) != AOC_SUCCESS)))
 		{
-			total += (tmp.x * 3 + tmp.y);
+			return AOC_FAILURE;
 		}
 	}
 
-	return total;
+	return AOC_SUCCESS;
 }
 
 #define PART_2_OFFSET (10000000000000)
 
-int main(int argc, char **argv)
+struct dayInput
 {
-	size_t i;
+	struct entry *entry_arr;
+	size_t entry_len;
+};
+
+static void dayFree(void *ctx)
+{
+	struct dayInput *in = ctx;
 
-	if (argc < 2)
+	if (in != NULL)
 	{
-		fputs("Please provide a file or files to act upon\n", stderr);
+		AOC_FREE(in->entry_arr);
+		AOC_FREE(in);
+	}
+}
 
-		return AOC_FAILURE;
+static void* dayParse(const struct aocView *input)
+{
+	struct dayInput *in = NULL;
+
+	if ((in = calloc(1, sizeof(struct dayInput))) == NULL)
+	{
+		return NULL;
 	}
 
-	for (i = 1; i < argc; i++)
+	if (parseFile(input, &in->entry_arr, &in->entry_len) == AOC_FAILURE)
 	{
-		FILE *input = NULL;
-		struct entry *entry_arr = NULL;
-		size_t entry_len;
+		dayFree(in);
 
-		if ((input = fopen(argv[i], "rb")) == NULL)
-		{
-			fprintf(stderr, "Failed to open file '%s'\n", argv[i]);
+		return NULL;
+	}
 
-			continue;
-		}
+	return in;
+}
 
-		if (parseFile(input, &entry_arr, &entry_len) == AOC_FAILURE)
-		{
-			fprintf(stderr, "Failed to parse file values, '%s'\n", 
-				argv[i]);
+static AOC_STAT dayPart1(void *ctx, AOC_ACC *answer)
+{
+	const struct dayInput *in = ctx;
 
-			fclose(input);
-			AOC_FREE(entry_arr);
-		}
+	return getTotalCoins(in->entry_arr, in->entry_len, 0, answer);
+}
 
-		fprintf(stdout, "Part 1: %ld\n", 
-			getTotalCoins(entry_arr, entry_len, 0));
-		fprintf(stdout, "Part 2: %ld\n", 
-			getTotalCoins(entry_arr, entry_len, PART_2_OFFSET));
-		fclose(input);
-		AOC_FREE(entry_arr);
-	}
+static AOC_STAT dayPart2(void *ctx, AOC_ACC *answer)
+{
+	const struct dayInput *in = ctx;
 
-	return AOC_SUCCESS;
+	return getTotalCoins(in->entry_arr, in->entry_len, PART_2_OFFSET, 
+		answer);
 }
 
+const struct aocDay aoc_day_13 =
+{
+	13, dayParse, dayPart1, dayPart2, dayFree,
+	"Part 1: %s\n",
+	"Part 2: %s\n"
+};
+
+#ifndef AOC_NO_MAIN
+int main(int argc, char **argv)
+{
+	return runDayMain(&aoc_day_13, argc, argv);
+}
+#endif /* AOC_NO_MAIN */
@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "../aocCommon.h"
 
@@ -18,23 +19,34 @@ struct robot
 	struct coordinate velocity;
 };
 
-static AOC_STAT parseInput(FILE *input, struct robot **out, size_t *out_len)
+static AOC_STAT parseInput(const struct aocView *input, struct robot **out, 
+	size_t *out_len)
 {
-	const char format[] = "p=%ld,%ld v=%ld,%ld\n";
+	struct aocCursor curs;
 	struct robot *working = NULL;
 	struct robot tmp;
 	size_t len = 0;
-	size_t max = 10;
+	size_t max = 0;
 
 	if ((input == NULL) || (out == NULL) || (out_len == NULL))
 	{
 		return AOC_FAILURE;
 	}
 
-	AOC_NEW_DYN_ARR(struct robot, working, max);
-
-	while (fscanf(input, format, &tmp.position.x_pos, &tmp.position.y_pos, 
-		&tmp.velocity.x_pos, &tmp.velocity.y_pos) == 4)
+	/* One robot per line, with room for at least one so that an empty
+	 * input still leaves an array for the parts */
+	AOC_RESERVE_DYN_ARR(struct robot, working, max,
+		AOC_MAX(viewEstimateLines(input, 0, input->len), 1));
+	cursorInit(&curs, input->data, input->len);
+
+	while ((scanLabeledLong(&curs, "p=", &tmp.position.x_pos)
+		== AOC_SUCCESS)
+	&& (scanLabeledLong(&curs, ",", &tmp.position.y_pos)
+		== AOC_SUCCESS)
+	&& (scanLabeledLong(&curs, "v=", &tmp.velocity.x_pos)
+		== AOC_SUCCESS)
+	&& (scanLabeledLong(&curs, ",", &tmp.velocity.y_pos)
+		== AOC_SUCCESS))
 	{
 		AOC_CAT_DYN_ARR(struct robot, working, len, max, tmp);
 	}
@@ -45,6 +57,9 @@ static AOC_STAT parseInput(FILE *input, struct robot **out, size_t *out_len)
 	return AOC_SUCCESS;
 }
 
+/* Debug output of the parsed robots and of each new best candidate image for
+ * part 2, build with -DAOC_VERBOSE to see them */
+#if defined(AOC_VERBOSE)
 static void dumpArr(const struct robot * const arr, const size_t len)
 {
 	size_t i;
@@ -56,6 +71,7 @@ static void dumpArr(const struct robot * const arr, const size_t len)
 			arr[i].velocity.x_pos, arr[i].velocity.y_pos);
 	}
 }
+#endif /* AOC_VERBOSE */
 
 static int getQuadrant(const struct coordinate final, 
 	const struct coordinate bounds)
@@ -76,16 +92,33 @@ static int getQuadrant(const struct coordinate final,
 	return x_res + y_res;
 }
 
-static long int calculatePart1(const struct robot * const arr, 
-	const size_t len, const struct coordinate bounds)
+/* The product of the robots in each quadrant */
+static AOC_STAT safetyFactor(const int quadrants[4], AOC_ACC *factor)
+{
+	size_t i;
+
+	*factor = quadrants[0];
+
+	for (i = 1; i < 4; i++)
+	{
+		if (accMul(factor, quadrants[i]) != AOC_SUCCESS)
+		{
+			return AOC_FAILURE;
+		}
+	}
+
+	return AOC_SUCCESS;
+}
+
+static AOC_STAT calculatePart1(const struct robot * const arr, 
+	const size_t len, const struct coordinate bounds, AOC_ACC *total)
 {
-	long int total = -1;
 	int quadrants[4] = {0};
 	size_t i;
 
 	if (arr == NULL)
 	{
-		return -1;
+		return AOC_FAILURE;
 	}
 
 	for (i = 0; i < len; i++)
@@ -114,21 +147,10 @@ static long int calculatePart1(const struct robot * const arr,
 		}
 	}
 
-	for (i = 0; i < 4; i++)
-	{
-		if (total == -1)
-		{
-			total = quadrants[i];
-		}
-		else
-		{
-			total *= quadrants[i];
-		}
-	}
-
-	return total;
+	return safetyFactor(quadrants, total);
 }
 
+#if defined(AOC_VERBOSE)
 static int compareRobots(const void *foo, const void *bar)
 {
 	const struct robot *left = (struct robot *) foo;
@@ -136,11 +158,13 @@ static int compareRobots(const void *foo, const void *bar)
 
 	if (left->position.y_pos != right->position.y_pos)
 	{
-		return left->position.y_pos - right->position.y_pos;
+		return (left->position.y_pos > right->position.y_pos)
+			- (left->position.y_pos < right->position.y_pos);
 	}
 	else
 	{
-		return left->position.x_pos - right->position.x_pos;
+		return (left->position.x_pos > right->position.x_pos)
+			- (left->position.x_pos < right->position.x_pos);
 	}
 }
 
@@ -181,22 +205,23 @@ static void dumpImage(struct robot *arr, const size_t len,
 
 	fputc('\n', stdout);
 }
+#endif /* AOC_VERBOSE */
 
-static long int estimatePart2(struct robot *arr, const size_t len, 
-	const struct coordinate bounds)
+static AOC_STAT estimatePart2(struct robot *arr, const size_t len, 
+	const struct coordinate bounds, AOC_ACC *estimate)
 {	
-	long int lowest = -1;
-	size_t i, j, best;
+	AOC_ACC lowest = -1;
+	size_t i, j, best = 0;
 
 	if (arr == NULL)
 	{
-		return -1;
+		return AOC_FAILURE;
 	}
 
 	for (j = 0; j < TIME_STEP_MAX; j++)
 	{
 		int quadrants[4] = {0};
-		int total = -1;
+		AOC_ACC total;
 
 		for (i = 0; i < len; i++)
 		{
@@ -224,74 +249,93 @@ static long int estimatePart2(struct robot *arr, const size_t len,
 			}
 		}
 
-		for (i = 0; i < 4; i++)
+		if (safetyFactor(quadrants, &total) != AOC_SUCCESS)
 		{
-			if (total == -1)
-			{
-				total = quadrants[i];
-			}
-			else
-			{
-				total *= quadrants[i];
-			}
+			return AOC_FAILURE;
 		}
 
 		if ((lowest == -1) || (total < lowest))
 		{
+#if defined(AOC_VERBOSE)
 			dumpImage(arr, len, bounds);
+#endif /* AOC_VERBOSE */
 			lowest = total;
 			best = j;
 		}
 	}
 
-	return best + 1;
+	*estimate = best + 1;
+
+	return AOC_SUCCESS;
 }
 
-int main(int argc, char **argv)
+static const struct coordinate room_bounds = {101, 103};
+
+struct dayInput
 {
-	const struct coordinate bounds = {101, 103};
-	int ret = 0;
-	size_t i;
+	struct robot *arr;
+	size_t len;
+};
+
+static void dayFree(void *ctx)
+{
+	struct dayInput *in = ctx;
 
-	if (argc < 2)
+	if (in != NULL)
 	{
-		fputs("Please provide a file or files to act upon\n", stderr);
+		AOC_FREE(in->arr);
+		AOC_FREE(in);
+	}
+}
 
-		return AOC_FAILURE;
+static void* dayParse(const struct aocView *input)
+{
+	struct dayInput *in = NULL;
+
+	if ((in = calloc(1, sizeof(struct dayInput))) == NULL)
+	{
+		return NULL;
 	}
 
-	for (i = 1; i < argc; i++)
+	if (parseInput(input, &in->arr, &in->len) == AOC_FAILURE)
 	{
-		FILE *input = fopen(argv[i], "rb");
-		struct robot *arr;
-		size_t len;
-		long int total, check;
+		dayFree(in);
 
-		if (input == NULL)
-		{
-			fprintf(stderr, "Failed to open file '%s'\n", argv[i]);
-			ret++;
+		return NULL;
+	}
 
-			continue;
-		}
+#if defined(AOC_VERBOSE)
+	dumpArr(in->arr, in->len);
+#endif /* AOC_VERBOSE */
 
-		if (parseInput(input, &arr, &len) == AOC_FAILURE)
-		{
-			fprintf(stderr, "Faled to parse file '%s'\n", argv[i]);
-			ret++;
+	return in;
+}
 
-			continue;
-		}
+static AOC_STAT dayPart1(void *ctx, AOC_ACC *answer)
+{
+	const struct dayInput *in = ctx;
 
-		dumpArr(arr, len);
-		fprintf(stdout, "Part 1: %ld\n", 
-			calculatePart1(arr, len, bounds));
-		fprintf(stdout, "Part 2: likely %ld\n", 
-			estimatePart2(arr, len, bounds));
-		AOC_FREE(arr);
-		fclose(input);
-	}
+	return calculatePart1(in->arr, in->len, room_bounds, answer);
+}
 
-	return ret;
+/* Steps the robots forward in place so this has to run after part 1 */
+static AOC_STAT dayPart2(void *ctx, AOC_ACC *answer)
+{
+	struct dayInput *in = ctx;
+
+	return estimatePart2(in->arr, in->len, room_bounds, answer);
 }
 
+const struct aocDay aoc_day_14 =
+{
+	14, dayParse, dayPart1, dayPart2, dayFree,
+	"Part 1: %s\n",
+	"Part 2: likely %s\n"
+};
+
+#ifndef AOC_NO_MAIN
+int main(int argc, char **argv)
+{
+	return runDayMain(&aoc_day_14, argc, argv);
+}
+#endif /* AOC_NO_MAIN */
@@ -0,0 +1,769 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../aocCommon.h"
+
+/* Writes a synthetic but valid puzzle input for any of the days to stdout so
+ * that the solutions can be stressed well beyond puzzle scale. The same day,
+ * size, seed, and density always produce the same bytes on every platform.
+ *
+ * usage: aocgen day [-n size] [-s seed] [-d density]
+ *
+ * What the size counts depends on the day, it is the number of lines or
+ * records for the list style inputs, the side length of the grid inputs, and
+ * the length in bytes or digits for days 3 and 9. Density is a percentage
+ * whose meaning is also per day, see the generators below. Leaving either out
+ * gives something close to the shape of the real puzzle input.
+ *
+ * Some answers need a 64-bit long, as do the solutions for days 7 and 13,
+ * and large enough sizes need the 128 bit accumulator of -DAOC_ACC_128 */
+#define DEFAULT_SEED (2024)
+
+struct genParams
+{
+	size_t size;
+	int density;
+};
+
+/* xorshift32, masked so that a wider unsigned long gives the same sequence */
+static unsigned long int rng_state = DEFAULT_SEED;
+
+static void seedRandom(const unsigned long int seed)
+{
+	/* Zero is the one state xorshift can't leave */
+	rng_state = ((seed & 0xFFFFFFFFul) != 0) ? (seed & 0xFFFFFFFFul) : 1;
+}
+
+static unsigned long int nextRandom(void)
+{
+	rng_state ^= (rng_state << 13) & 0xFFFFFFFFul;
+	rng_state ^= rng_state >> 17;
+	rng_state ^= (rng_state << 5) & 0xFFFFFFFFul;
+
+	return rng_state;
+}
+
+/* Inclusive of both ends, the slight modulo bias doesn't matter here */
+static long int randomRange(const long int low, const long int high)
+{
+	return low + (long int) (nextRandom() % (unsigned long int)
+		(high - low + 1));
+}
+
+static AOC_BOOL randomChance(const int percent)
+{
+	return (randomRange(0, 99) < percent) ? AOC_TRUE : AOC_FALSE;
+}
+
+static int compareLongs(const void *left, const void *right)
+{
+	const long int foo = *(const long int *) left;
+	const long int bar = *(const long int *) right;
+
+	return (foo > bar) - (foo < bar);
+}
+
+static void shuffleLongs(long int *arr, const size_t len)
+{
+	size_t i;
+
+	for (i = len; i > 1; i--)
+	{
+		const size_t j = randomRange(0, i - 1);
+
+		AOC_SWAP(long int, arr[i - 1], arr[j]);
+	}
+}
+
+/* Writes a grid held as rows * cols chars with newlines after each row */
+static void writeGrid(const char *cells, const size_t rows, const size_t cols)
+{
+	size_t j;
+
+	for (j = 0; j < rows; j++)
+	{
+		fwrite(cells + (j * cols), 1, cols, stdout);
+		fputc('\n', stdout);
+	}
+}
+
+/* Density is how many of the right hand values are copied from the left
+ * list, giving the similarity score something to find */
+static void genDay01(const struct genParams *params)
+{
+	long int *left = NULL;
+	size_t i;
+
+	AOC_NEW_DYN_ARR(long int, left, params->size + 1);
+
+	for (i = 0; i < params->size; i++)
+	{
+		left[i] = randomRange(10000, 99999);
+	}
+
+	for (i = 0; i < params->size; i++)
+	{
+		const AOC_BOOL is_copy = randomChance(params->density);
+		const long int right = (is_copy == AOC_TRUE)
+			? left[randomRange(0, params->size - 1)]
+			: randomRange(10000, 99999);
+
+		fprintf(stdout, "%ld   %ld\n", left[i], right);
+	}
+
+	AOC_FREE(left);
+}
+
+/* Density is the share of reports built to be safe, the rest get one bad
+ * step which the dampener may or may not be able to remove */
+static void genDay02(const struct genParams *params)
+{
+	size_t i;
+
+	for (i = 0; i < params->size; i++)
+	{
+		const int len = randomRange(5, 8);
+		const int dir = (randomChance(50) == AOC_TRUE) ? 1 : -1;
+		const int bad = (randomChance(params->density) == AOC_TRUE)
+			? -1
+			: (int) randomRange(0, len - 1);
+		long int level = (dir > 0) ? randomRange(10, 30)
+			: randomRange(60, 90);
+		int j;
+
+		for (j = 0; j < len; j++)
+		{
+			fprintf(stdout, (j == 0) ? "%ld" : " %ld", level);
+			level += (j == bad)
+				? (randomRange(4, 6) * -dir)
+				: (randomRange(1, 3) * dir);
+		}
+
+		fputc('\n', stdout);
+	}
+}
+
+/* Density is the share of tokens that are well formed instructions, the
+ * rest are near misses and noise */
+static void genDay03(const struct genParams *params)
+{
+	static const char * const noise[] =
+	{
+		"mul(", "mul[", "mul(4*", "mul ( 2 , 4 )", "do(", "don't",
+		")", ",", "select()", "how()", "#", "^", "%", "&", "!", "?",
+		"what()", "+", "mul(32,64]", "where()", "from()", "when()"
+	};
+	const size_t num_noise = sizeof(noise) / sizeof(noise[0]);
+	size_t written = 0;
+
+	while (written < params->size)
+	{
+		char buf[64];
+
+		if (randomChance(params->density) == AOC_TRUE)
+		{
+			const long int roll = randomRange(0, 19);
+
+			if (roll == 0)
+			{
+				strcpy(buf, "do()");
+			}
+			else if (roll == 1)
+			{
+				strcpy(buf, "don't()");
+			}
+			else
+			{
+				const long int left = randomRange(1, 999);
+
+				sprintf(buf, "mul(%ld,%ld)", left, 
+					randomRange(1, 999));
+			}
+		}
+		else
+		{
+			strcpy(buf, noise[randomRange(0, num_noise - 1)]);
+		}
+
+		written += strlen(buf);
+		fputs(buf, stdout);
+
+		/* Line breaks in the same places the puzzle has them */
+		if ((written / 3000) != ((written - strlen(buf)) / 3000))
+		{
+			fputc('\n', stdout);
+			written++;
+		}
+	}
+
+	fputc('\n', stdout);
+}
+
+/* Density is the chance of planting a full "XMAS" at each cell, the letters
+ * in between are otherwise random */
+static void genDay04(const struct genParams *params)
+{
+	static const char word[] = "XMAS";
+	const long int side = params->size;
+	char *cells = NULL;
+	long int x, y;
+
+	AOC_NEW_DYN_ARR(char, cells, side * side);
+
+	for (y = 0; y < side; y++)
+	{
+		for (x = 0; x < side; x++)
+		{
+			cells[(y * side) + x] = word[randomRange(0, 3)];
+		}
+	}
+
+	for (y = 0; y < side; y++)
+	{
+		for (x = 0; x < side; x++)
+		{
+			const long int dx = randomRange(-1, 1);
+			const long int dy = randomRange(-1, 1);
+			const long int end_x = x + (dx * 3);
+			const long int end_y = y + (dy * 3);
+			int k;
+
+			if ((randomChance(params->density) == AOC_FALSE)
+			|| ((dx == 0) && (dy == 0))
+			|| (end_x < 0) || (end_x >= side)
+			|| (end_y < 0) || (end_y >= side))
+			{
+				continue;
+			}
+
+			for (k = 0; k < 4; k++)
+			{
+				cells[((y + (dy * k)) * side) + x + (dx * k)]
+					= word[k];
+			}
+		}
+	}
+
+	writeGrid(cells, side, side);
+	AOC_FREE(cells);
+}
+
+/* Pages follow one hidden total order so the rules never contradict each
+ * other and every update can be fixed. Density is the share of ordered page
+ * pairs that get a rule, half of the updates come out already in order */
+#define DAY05_NUM_PAGES (49)
+
+static void genDay05(const struct genParams *params)
+{
+	long int order[DAY05_NUM_PAGES];
+	long int update[DAY05_NUM_PAGES];
+	size_t i, j;
+
+	for (i = 0; i < DAY05_NUM_PAGES; i++)
+	{
+		order[i] = 11 + (long int) i;
+	}
+
+	shuffleLongs(order, DAY05_NUM_PAGES);
+
+	for (i = 0; i < DAY05_NUM_PAGES; i++)
+	{
+		for (j = i + 1; j < DAY05_NUM_PAGES; j++)
+		{
+			if (randomChance(params->density) == AOC_TRUE)
+			{
+				fprintf(stdout, "%ld|%ld\n", order[i],
+					order[j]);
+			}
+		}
+	}
+
+	fputc('\n', stdout);
+
+	for (i = 0; i < params->size; i++)
+	{
+		const size_t len = (randomRange(2, 11) * 2) + 1;
+		long int picked[DAY05_NUM_PAGES];
+
+		/* Choose 'len' distinct positions in the order, kept sorted so
+		 * that the update starts out correctly ordered */
+		for (j = 0; j < DAY05_NUM_PAGES; j++)
+		{
+			picked[j] = j;
+		}
+
+		shuffleLongs(picked, DAY05_NUM_PAGES);
+		qsort(picked, len, sizeof(long int), compareLongs);
+
+		for (j = 0; j < len; j++)
+		{
+			update[j] = order[picked[j]];
+		}
+
+		if (randomChance(50) == AOC_TRUE)
+		{
+			shuffleLongs(update, len);
+		}
+
+		for (j = 0; j < len; j++)
+		{
+			fprintf(stdout, (j == 0) ? "%ld" : ",%ld", update[j]);
+		}
+
+		fputc('\n', stdout);
+	}
+}
+
+/* Density is the share of cells holding an obstruction. Any loop the guard
+ * would get stuck in is broken by clearing the obstruction it last turned
+ * at, so the guard always walks off of the map as part 1 expects */
+static void genDay06(const struct genParams *params)
+{
+	static const long int step_x[4] = {0, 1, 0, -1};
+	static const long int step_y[4] = {-1, 0, 1, 0};
+	const long int side = params->size;
+	unsigned char *seen = NULL;
+	char *cells = NULL;
+	long int start_x, start_y;
+	long int i;
+
+	AOC_NEW_DYN_ARR(char, cells, side * side);
+	AOC_NEW_DYN_ARR(unsigned char, seen, side * side);
+
+	for (i = 0; i < side * side; i++)
+	{
+		cells[i] = (randomChance(params->density) == AOC_TRUE)
+			? '#'
+			: '.';
+	}
+
+	start_x = randomRange(0, side - 1);
+	start_y = randomRange(0, side - 1);
+	cells[(start_y * side) + start_x] = '^';
+
+	for (;;)
+	{
+		long int x = start_x;
+		long int y = start_y;
+		long int last_turn = -1;
+		int dir = 0;
+
+		memset(seen, 0, side * side);
+
+		for (;;)
+		{
+			const long int new_x = x + step_x[dir];
+			const long int new_y = y + step_y[dir];
+			const long int pos = (y * side) + x;
+
+			if (seen[pos] & (1 << dir))
+			{
+				break;
+			}
+
+			seen[pos] |= (1 << dir);
+
+			if ((new_x < 0) || (new_x >= side)
+			|| (new_y < 0) || (new_y >= side))
+			{
+				break;
+			}
+
+			if (cells[(new_y * side) + new_x] == '#')
+			{
+				last_turn = (new_y * side) + new_x;
+				dir = (dir + 1) % 4;
+			}
+			else
+			{
+				x = new_x;
+				y = new_y;
+			}
+		}
+
+		if (((x + step_x[dir] >= 0) && (x + step_x[dir] < side)
+			&& (y + step_y[dir] >= 0) && (y + step_y[dir] < side))
+		&& (last_turn >= 0))
+		{
+			cells[last_turn] = '.';
+
+			continue;
+		}
+
+		break;
+	}
+
+	writeGrid(cells, side, side);
+	AOC_FREE(seen);
+	AOC_FREE(cells);
+}
+
+/* Density is the share of equations whose test value can be reached, the
+ * operators are drawn from all three so some need concatenation. Operand
+ * counts and sizes are kept small enough that no result overflows */
+static void genDay07(const struct genParams *params)
+{
+	size_t i;
+
+	for (i = 0; i < params->size; i++)
+	{
+		long int vals[8];
+		const int len = randomRange(2, 8);
+		long int total;
+		int j;
+
+		for (j = 0; j < len; j++)
+		{
+			vals[j] = randomRange(1, 99);
+		}
+
+		total = vals[0];
+
+		for (j = 1; j < len; j++)
+		{
+			const long int op = randomRange(0, 2);
+
+			if (op == 0)
+			{
+				total += vals[j];
+			}
+			else if (op == 1)
+			{
+				total *= vals[j];
+			}
+			else
+			{
+				total = (total * ((vals[j] < 10) ? 10 : 100))
+					+ vals[j];
+			}
+		}
+
+		if (randomChance(params->density) == AOC_FALSE)
+		{
+			total += randomRange(1, 9);
+		}
+
+		fprintf(stdout, "%ld:", total);
+
+		for (j = 0; j < len; j++)
+		{
+			fprintf(stdout, " %ld", vals[j]);
+		}
+
+		fputc('\n', stdout);
+	}
+}
+
+/* Density is the share of cells holding an antenna */
+static void genDay08(const struct genParams *params)
+{
+	static const char freqs[] = "0123456789"
+		"abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+	const long int side = params->size;
+	char *cells = NULL;
+	long int i;
+
+	AOC_NEW_DYN_ARR(char, cells, side * side);
+
+	for (i = 0; i < side * side; i++)
+	{
+		cells[i] = (randomChance(params->density) == AOC_TRUE)
+			? freqs[randomRange(0, sizeof(freqs) - 2)]
+			: '.';
+	}
+
+	writeGrid(cells, side, side);
+	AOC_FREE(cells);
+}
+
+/* Density is the chance of each gap between files being non-empty */
+static void genDay09(const struct genParams *params)
+{
+	size_t i;
+
+	for (i = 0; i < params->size; i++)
+	{
+		if ((i % 2) == 0)
+		{
+			fputc('0' + (int) randomRange(1, 9), stdout);
+		}
+		else
+		{
+			fputc((randomChance(params->density) == AOC_TRUE)
+				? '0' + (int) randomRange(1, 9)
+				: '0', stdout);
+		}
+	}
+
+	fputc('\n', stdout);
+}
+
+/* Random heights with trails laid over them, density is how many trails
+ * are started per hundred cells. Each trail climbs from 0 to 9 one step at
+ * a time so there is always something for part 1 to find */
+static void genDay10(const struct genParams *params)
+{
+	static const long int step_x[4] = {0, 1, 0, -1};
+	static const long int step_y[4] = {-1, 0, 1, 0};
+	const long int side = params->size;
+	const long int num_trails = ((side * side) * params->density) / 100;
+	char *cells = NULL;
+	long int i;
+
+	AOC_NEW_DYN_ARR(char, cells, side * side);
+
+	for (i = 0; i < side * side; i++)
+	{
+		cells[i] = '0' + (char) randomRange(0, 9);
+	}
+
+	for (i = 0; i < num_trails; i++)
+	{
+		long int x = randomRange(0, side - 1);
+		long int y = randomRange(0, side - 1);
+		int height;
+
+		for (height = 0; height < 10; height++)
+		{
+			const int dir = randomRange(0, 3);
+
+			cells[(y * side) + x] = '0' + height;
+
+			if ((x + step_x[dir] < 0) || (x + step_x[dir] >= side)
+			|| (y + step_y[dir] < 0) || (y + step_y[dir] >= side))
+			{
+				break;
+			}
+
+			x += step_x[dir];
+			y += step_y[dir];
+		}
+	}
+
+	writeGrid(cells, side, side);
+	AOC_FREE(cells);
+}
+
+/* Density is the share of stones with an even number of digits, which are
+ * the ones that split straight away */
+static void genDay11(const struct genParams *params)
+{
+	size_t i;
+
+	for (i = 0; i < params->size; i++)
+	{
+		const AOC_BOOL is_even = randomChance(params->density);
+		const AOC_BOOL is_long = randomChance(50);
+		long int val;
+
+		/* Repeating the digits keeps the digit count even or odd */
+		if (is_even == AOC_TRUE)
+		{
+			val = randomRange(10, 99);
+			val *= (is_long == AOC_TRUE) ? 101 : 1;
+		}
+		else
+		{
+			val = randomRange(0, 9);
+			val *= (is_long == AOC_TRUE) ? 10101 : 1;
+		}
+
+		fprintf(stdout, (i == 0) ? "%ld" : " %ld", val);
+	}
+
+	fputc('\n', stdout);
+}
+
+/* Density is the chance of each plot continuing the region to its left or
+ * above, so higher densities grow larger and more irregular regions */
+static void genDay12(const struct genParams *params)
+{
+	const long int side = params->size;
+	char *cells = NULL;
+	long int x, y;
+
+	AOC_NEW_DYN_ARR(char, cells, side * side);
+
+	for (y = 0; y < side; y++)
+	{
+		for (x = 0; x < side; x++)
+		{
+			char *cell = &cells[(y * side) + x];
+
+			if ((randomChance(params->density) == AOC_FALSE)
+			|| ((x == 0) && (y == 0)))
+			{
+				*cell = 'A' + (char) randomRange(0, 25);
+			}
+			else if ((y == 0)
+			|| ((x != 0) && (randomChance(50) == AOC_TRUE)))
+			{
+				*cell = cell[-1];
+			}
+			else
+			{
+				*cell = cell[-side];
+			}
+		}
+	}
+
+	writeGrid(cells, side, side);
+	AOC_FREE(cells);
+}
+
+/* Density is the share of machines whose prize can be won, the buttons of
+ * every machine are never parallel so there is exactly one way to move */
+static void genDay13(const struct genParams *params)
+{
+	size_t i;
+
+	for (i = 0; i < params->size; i++)
+	{
+		long int ax, ay, bx, by, px, py;
+
+		do
+		{
+			ax = randomRange(10, 99);
+			ay = randomRange(10, 99);
+			bx = randomRange(10, 99);
+			by = randomRange(10, 99);
+		} while ((ax * by) == (ay * bx));
+
+		if (randomChance(params->density) == AOC_TRUE)
+		{
+			const long int a = randomRange(1, 100);
+			const long int b = randomRange(1, 100);
+
+			px = (a * ax) + (b * bx);
+			py = (a * ay) + (b * by);
+		}
+		else
+		{
+			px = randomRange(1000, 19999);
+			py = randomRange(1000, 19999);
+		}
+
+		fprintf(stdout, "%sButton A: X+%ld, Y+%ld\n"
+			"Button B: X+%ld, Y+%ld\nPrize: X=%ld, Y=%ld\n",
+			(i == 0) ? "" : "\n", ax, ay, bx, by, px, py);
+	}
+}
+
+/* Robots inside the 101 by 103 room day 14 is fixed to, density is the
+ * share of robots moving faster than one room width per second */
+static void genDay14(const struct genParams *params)
+{
+	size_t i;
+
+	for (i = 0; i < params->size; i++)
+	{
+		const AOC_BOOL is_fast = randomChance(params->density);
+		const long int limit = (is_fast == AOC_TRUE) ? 200 : 99;
+		const long int px = randomRange(0, 100);
+		const long int py = randomRange(0, 102);
+		const long int vx = randomRange(-limit, limit);
+		const long int vy = randomRange(-limit, limit);
+
+		/* Drawn one at a time, argument evaluation order isn't fixed */
+		fprintf(stdout, "p=%ld,%ld v=%ld,%ld\n", px, py, vx, vy);
+	}
+}
+
+static const struct
+{
+	void (*Generate)(const struct genParams *);
+	size_t default_size;
+	int default_density;
+} generators[] =
+{
+	{genDay01, 1000,  10},
+	{genDay02, 1000,  50},
+	{genDay03, 18000, 30},
+	{genDay04, 140,   5},
+	{genDay05, 200,   100},
+	{genDay06, 130,   2},
+	{genDay07, 850,   50},
+	{genDay08, 50,    4},
+	{genDay09, 19999, 90},
+	{genDay10, 50,    2},
+	{genDay11, 8,     50},
+	{genDay12, 140,   85},
+	{genDay13, 320,   50},
+	{genDay14, 500,   10}
+};
+
+static AOC_STAT parseNumber(const char *arg, unsigned long int *out)
+{
+	char *end = NULL;
+
+	if ((arg == NULL) || (*arg == '-'))
+	{
+		return AOC_FAILURE;
+	}
+
+	*out = strtoul(arg, &end, 10);
+
+	return ((end != arg) && (*end == '\0')) ? AOC_SUCCESS : AOC_FAILURE;
+}
+
+int main(int argc, char **argv)
+{
+	const size_t num_days = sizeof(generators) / sizeof(generators[0]);
+	struct genParams params;
+	unsigned long int day = 0;
+	unsigned long int seed = DEFAULT_SEED;
+	unsigned long int val;
+	int i;
+
+	if ((argc < 2) || (parseNumber(argv[1], &day) != AOC_SUCCESS)
+	|| (day < 1) || (day > num_days))
+	{
+		fprintf(stderr, "usage: aocgen day [-n size] [-s seed] "
+			"[-d density], day being 1 to %lu\n",
+			(unsigned long int) num_days);
+
+		return AOC_FAILURE;
+	}
+
+	params.size = generators[day - 1].default_size;
+	params.density = generators[day - 1].default_density;
+
+	for (i = 2; i + 1 < argc; i += 2)
+	{
+		if (parseNumber(argv[i + 1], &val) != AOC_SUCCESS)
+		{
+			break;
+		}
+
+		if (strcmp(argv[i], "-n") == 0)
+		{
+			params.size = val;
+		}
+		else if (strcmp(argv[i], "-s") == 0)
+		{
+			seed = val;
+		}
+		else if ((strcmp(argv[i], "-d") == 0) && (val <= 100))
+		{
+			params.density = val;
+		}
+		else
+		{
+			break;
+		}
+	}
+
+	if ((i < argc) || (params.size == 0))
+	{
+		fprintf(stderr, "Bad option '%s'\n", 
+			argv[AOC_MIN(i, argc - 1)]);
+
+		return AOC_FAILURE;
+	}
+
+	seedRandom(seed);
+	generators[day - 1].Generate(&params);
+
+	return (fflush(stdout) == 0) ? AOC_SUCCESS : AOC_FAILURE;
+}